@@ -220,7 +220,7 @@
  * Requires <c>ANJAY_WITH_LWM2M11</c> and either <c>ANJAY_WITH_SENML_JSON</c> or
  * <c>ANJAY_WITH_CBOR</c> to be enabled.
  */
-/* #undef ANJAY_WITH_SEND */
+#define ANJAY_WITH_SEND
 
 /**
  * Enable support for the SMS binding and the SMS trigger mechanism.
@@ -323,14 +323,14 @@
  *
  * Requires <c>ANJAY_WITH_LWM2M11</c> to be enabled.
  */
-/* #undef ANJAY_WITH_SENML_JSON */
+#define ANJAY_WITH_SENML_JSON
 
 /**
  * Enable support for CBOR and SenML CBOR formats, as specified in LwM2M TS 1.1.
  *
  * Requires <c>ANJAY_WITH_LWM2M11</c> to be enabled.
  */
-/* #undef ANJAY_WITH_CBOR */
+#define ANJAY_WITH_CBOR
 
 /**
  * Enable support for Enrollment over Secure Transport.
@@ -473,7 +473,7 @@
  * The default value defined in CMake build scripts is
  * <c>AVS_COAP_FORMAT_NONE</c>.
  */
-#define ANJAY_DEFAULT_SEND_FORMAT AVS_COAP_FORMAT_NONE
+#define ANJAY_DEFAULT_SEND_FORMAT AVS_COAP_FORMAT_SENML_CBOR
 
 /**
  * Optional Anjay modules.
@@ -840,7 +840,7 @@
  * You might disable this option if for any reason you need to use a custom
  * allocator.
  */
-#define AVS_COMMONS_UTILS_WITH_STANDARD_ALLOCATOR
+/* #undef AVS_COMMONS_UTILS_WITH_STANDARD_ALLOCATOR */
 
 /**
  * Enable the alternate implementation of avs_malloc(), avs_free(), avs_calloc()
@@ -42,7 +42,13 @@ extern "C" {
 #endif
 
 /* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <avsystem/commons/avs_time.h>
+
 #include "dc_common.h"
+#include "main.h"
 #include "plf_config.h"
 
 /* Exported types ------------------------------------------------------------*/
@@ -52,6 +58,26 @@ typedef struct {
     dc_service_rt_state_t rt_state;
 } board_buttons_t;
 
+/* Inputs whose edges are reported as events */
+typedef enum {
+    /* BSP_BUTTON, i.e. the joystick selection if there is a joystick */
+    BOARD_BUTTONS_BUTTON,
+#ifdef BSP_JOYSTICK_PRESENT
+    BOARD_BUTTONS_JOY_UP,
+    BOARD_BUTTONS_JOY_DOWN,
+    BOARD_BUTTONS_JOY_LEFT,
+#endif /* BSP_JOYSTICK_PRESENT */
+    BOARD_BUTTONS_INPUTS_COUNT
+} board_buttons_input_t;
+
+/* Debounced edge of an input */
+typedef struct {
+    board_buttons_input_t input;
+    bool pressed;
+    /* Time of the edge, on the clock of avs_time_monotonic_now() */
+    avs_time_monotonic_t time;
+} board_buttons_event_t;
+
 typedef enum {
     BOARD_BUTTONS_OK = 0x00,
     BOARD_BUTTONS_ERROR
@@ -68,8 +94,28 @@ extern dc_com_res_id_t DC_BOARD_BUTTONS_SEL;
 
 /* Exported functions ------------------------------------------------------- */
 
-void board_button_joy_sel_press(void);
-void board_button_joy_sel_release(void);
+/**
+ * @brief  Handles an EXTI edge of one of the inputs, called from
+ *         HAL_GPIO_EXTI_Callback()
+ * @param  pin                 GPIO pin of the EXTI line
+ * @retval bool                true if the pin is one of the inputs
+ */
+bool board_buttons_irq_handler(uint16_t pin);
+
+/**
+ * @brief  Takes the oldest edge event from the queue; a single thread may
+ *         consume events
+ * @param  out_event           set to the event
+ * @retval bool                false if there is no event
+ */
+bool board_buttons_get_event(board_buttons_event_t *out_event);
+
+/**
+ * @brief  Debounced state of an input, as of its last event
+ * @param  input               input
+ * @retval bool                true if the input is pressed
+ */
+bool board_buttons_is_pressed(board_buttons_input_t input);
 
 board_buttons_status_t board_buttons_init(void);
 board_buttons_status_t board_buttons_start(void);
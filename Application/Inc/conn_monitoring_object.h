@@ -0,0 +1,34 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CONN_MONITORING_OBJECT_H
+#define CONN_MONITORING_OBJECT_H
+
+#include <anjay/anjay.h>
+
+#include <dc_common.h>
+
+int conn_monitoring_object_install(anjay_t *anjay);
+void conn_monitoring_object_update(anjay_t *anjay);
+
+/**
+ * Marks the resources backed by the given data cache entry as possibly changed.
+ * Called from the data cache callback, never blocks.
+ */
+void conn_monitoring_object_dc_event(dc_com_event_id_t dc_event_id);
+
+#endif // CONN_MONITORING_OBJECT_H
@@ -17,9 +17,12 @@
 #ifndef DEVICE_OBJECT_H
 #define DEVICE_OBJECT_H
 
+#include <stdbool.h>
+
 #include <anjay/anjay.h>
 
 int device_object_install(anjay_t *anjay);
+bool device_object_is_reboot_requested(void);
 void device_object_reboot_if_requested(void);
 
 #endif // DEVICE_OBJECT_H
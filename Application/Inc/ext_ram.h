@@ -0,0 +1,59 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef EXT_RAM_H
+#define EXT_RAM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Allocator of the external RAM, meant for large buffers which tolerate its
+ * higher access latency, so that they do not take internal SRAM away from the
+ * hot paths.
+ *
+ * Blocks are aligned to 8 bytes. On boards without external RAM, every
+ * allocation fails, so callers have to fall back to internal memory.
+ */
+
+/**
+ * Initializes the external RAM. Must be called once, before any allocation.
+ *
+ * @returns 0 on success, negative value if there is no usable external RAM.
+ */
+int ext_ram_init(void);
+
+/**
+ * Allocates @p size bytes of external RAM.
+ *
+ * @returns Pointer to the allocated block, or NULL if there is no external
+ *          RAM or not enough of it.
+ */
+void *ext_ram_alloc(size_t size);
+
+/**
+ * Frees a block allocated with @ref ext_ram_alloc. Does nothing if @p ptr is
+ * NULL.
+ */
+void ext_ram_free(void *ptr);
+
+/**
+ * Checks whether @p ptr points into the external RAM.
+ */
+bool ext_ram_contains(const void *ptr);
+
+#endif // EXT_RAM_H
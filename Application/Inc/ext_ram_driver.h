@@ -0,0 +1,35 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef EXT_RAM_DRIVER_H
+#define EXT_RAM_DRIVER_H
+
+#include <stddef.h>
+
+/**
+ * Initializes the external RAM of the board and maps it into the address
+ * space.
+ *
+ * @param out_base Set to the address the external RAM is mapped at.
+ * @param out_size Set to the size of the mapped region, or 0 if there is no
+ *                 external RAM on the board.
+ *
+ * @returns 0 on success, negative value otherwise.
+ */
+int ext_ram_driver_init(void **out_base, size_t *out_size);
+
+#endif // EXT_RAM_DRIVER_H
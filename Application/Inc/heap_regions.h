@@ -0,0 +1,75 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HEAP_REGIONS_H
+#define HEAP_REGIONS_H
+
+#include <stddef.h>
+
+/**
+ * The FreeRTOS heap (heap_5) spans the configTOTAL_HEAP_SIZE array, followed
+ * by the SRAM banks left unused by the linker script, see
+ * heap_regions_driver.h. Only the B-U585I-IOT02A without SBSFU has such a bank
+ * (SRAM4); on the other boards and configurations, the heap is the array
+ * alone, as it was with heap_4.
+ *
+ * heap_5 allocates from the lowest address which fits, so kernel objects and
+ * the stacks of the threads created at boot stay in the array, and SRAM4 only
+ * takes the overflow. The statically allocated DMA buffers, IPC RX buffer and
+ * stacks are not moved.
+ */
+
+typedef enum {
+    /**
+     * Allocated from the FreeRTOS heap, the same as pvPortMalloc().
+     */
+    HEAP_REGIONS_HOT,
+    /**
+     * Large buffers which tolerate a higher access latency, allocated only
+     * from the external RAM, so that they do not take on-chip SRAM away. Fails
+     * on boards without external RAM, so callers have to fall back to a
+     * smaller buffer in internal memory.
+     */
+    HEAP_REGIONS_COLD
+} heap_regions_placement_t;
+
+/**
+ * Defines the regions of the FreeRTOS heap. Must be called before any kernel
+ * object is created.
+ */
+void heap_regions_init(void);
+
+/**
+ * Logs the size of the heap defined by @ref heap_regions_init. Meant to be
+ * called once the log handler is set.
+ */
+void heap_regions_log_stats(void);
+
+/**
+ * Allocates @p size bytes according to @p placement.
+ *
+ * @returns Pointer to the allocated block, or NULL if there is not enough
+ *          memory.
+ */
+void *heap_regions_alloc(size_t size, heap_regions_placement_t placement);
+
+/**
+ * Frees a block allocated with @ref heap_regions_alloc. Does nothing if
+ * @p ptr is NULL.
+ */
+void heap_regions_free(void *ptr);
+
+#endif // HEAP_REGIONS_H
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HEAP_REGIONS_DRIVER_H
+#define HEAP_REGIONS_DRIVER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    uint8_t *base;
+    size_t size;
+} heap_regions_bank_t;
+
+/**
+ * Gets the on-chip SRAM banks of the board which are not used by the linker
+ * script, and thus can be added to the FreeRTOS heap. Clocks of the banks are
+ * enabled by this function.
+ *
+ * @param out_banks Filled with the banks, in increasing address order.
+ * @param max_banks Capacity of @p out_banks.
+ *
+ * @returns Number of banks written to @p out_banks.
+ */
+size_t heap_regions_driver_get_banks(heap_regions_bank_t *out_banks,
+                                     size_t max_banks);
+
+#endif // HEAP_REGIONS_DRIVER_H
@@ -19,9 +19,17 @@
 
 #include <anjay/anjay.h>
 
+#include "board_buttons.h"
+
 int joystick_object_install(anjay_t *anjay);
 void joystick_object_update(anjay_t *anjay);
 
-void joystick_object_increment_counter(void);
+/**
+ * Reports an edge of the joystick selection or of one of its directions.
+ * Must be called from the LwM2M thread, for each event in order, so that every
+ * press is counted.
+ */
+void joystick_object_handle_event(anjay_t *anjay,
+                                  const board_buttons_event_t *event);
 
 #endif /* JOYSTICK_OBJECT_H */
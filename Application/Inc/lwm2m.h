@@ -17,10 +17,48 @@
 #ifndef LWM2M_H
 #define LWM2M_H
 
+#include <stdbool.h>
+
 #include <anjay/core.h>
+#include <avsystem/commons/avs_time.h>
+
+#include "plf_config.h"
 
 extern anjay_t *volatile g_anjay;
 
+#ifdef ANJAY_WITH_SEND
+/**
+ * Adds a sample of a numeric Resource, timestamped with the current time, to
+ * the batch reported with LwM2M Send. The whole batch is sent as a single
+ * SenML CBOR message when it reaches LWM2M_SEND_BATCH_MAX_SAMPLES samples, or
+ * LWM2M_SEND_BATCH_MAX_DELAY_S after its first sample, whichever comes first.
+ * While the server is unreachable, the sample is appended to the measurement
+ * store in external flash instead, and sent later with its original timestamp.
+ *
+ * Must be called from the LwM2M thread.
+ */
+void lwm2m_send_batch_add_double(anjay_t *anjay,
+                                 anjay_oid_t oid,
+                                 anjay_iid_t iid,
+                                 anjay_rid_t rid,
+                                 double value);
+
+/**
+ * Adds a sample of a boolean Resource, taken at @p time on the monotonic clock,
+ * to the batch reported with LwM2M Send, as lwm2m_send_batch_add_double() does.
+ * Such samples are not kept in the measurement store, so they are lost if the
+ * batch cannot be sent.
+ *
+ * Must be called from the LwM2M thread.
+ */
+void lwm2m_send_batch_add_bool(anjay_t *anjay,
+                               anjay_oid_t oid,
+                               anjay_iid_t iid,
+                               anjay_rid_t rid,
+                               avs_time_monotonic_t time,
+                               bool value);
+#endif // ANJAY_WITH_SEND
+
 void lwm2m_init(void);
 
 void lwm2m_start(void);
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MEASUREMENT_STORE_H
+#define MEASUREMENT_STORE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <anjay/anjay.h>
+
+/**
+ * Store-and-forward queue of timestamped measurements, kept on external flash
+ * while the samples cannot be sent to the server.
+ *
+ * The store is a ring of flash sectors (see measurement_store_driver.h), each
+ * starting with a header holding its sequence number, followed by fixed-size
+ * records. Records are only ever appended; a record is written with its state
+ * byte left erased, which is programmed afterwards, so a record torn by a reset
+ * is never taken as valid. Sent records are marked by programming the state
+ * byte again, which needs no erase. When the ring is full, the oldest sector is
+ * erased and reused, dropping its records, so that all sectors wear evenly.
+ *
+ * Only the positions of the oldest and newest records are kept in RAM; they
+ * are recovered from flash by @ref measurement_store_init.
+ *
+ * None of the functions are thread-safe, they are meant to be called from the
+ * LwM2M thread only.
+ */
+
+typedef struct {
+    anjay_oid_t oid;
+    anjay_iid_t iid;
+    anjay_rid_t rid;
+    // Real time of the measurement, in milliseconds since the Unix epoch
+    int64_t timestamp_ms;
+    double value;
+} measurement_store_record_t;
+
+/**
+ * Position just past the records returned by @ref measurement_store_peek.
+ */
+typedef struct {
+    size_t sector;
+    size_t slot;
+    uint32_t generation;
+} measurement_store_cursor_t;
+
+/**
+ * Scans the flash for the stored records.
+ *
+ * @returns 0 on success, negative value if there is no flash for the store on
+ *          this board, or it could not be read.
+ */
+int measurement_store_init(void);
+
+bool measurement_store_is_available(void);
+
+bool measurement_store_is_empty(void);
+
+/**
+ * Appends a record, dropping the oldest sector of records if the store is full.
+ *
+ * @returns 0 on success, negative value otherwise.
+ */
+int measurement_store_append(const measurement_store_record_t *record);
+
+/**
+ * Reads up to @p max_records oldest records that are not marked as sent yet.
+ *
+ * @param out_records  Buffer for the records.
+ * @param max_records  Number of elements in @p out_records.
+ * @param out_cursor   Position to be passed to @ref measurement_store_mark_sent
+ *                     once the records are delivered.
+ *
+ * @returns Number of records read, or negative value in case of error.
+ */
+int measurement_store_peek(measurement_store_record_t *out_records,
+                           size_t max_records,
+                           measurement_store_cursor_t *out_cursor);
+
+/**
+ * Marks all records before @p cursor as sent. Does nothing if some of these
+ * records have been dropped in the meantime to make room for new ones.
+ *
+ * @returns 0 on success, negative value otherwise.
+ */
+int measurement_store_mark_sent(const measurement_store_cursor_t *cursor);
+
+#endif // MEASUREMENT_STORE_H
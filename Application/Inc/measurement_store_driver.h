@@ -0,0 +1,42 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MEASUREMENT_STORE_DRIVER_H
+#define MEASUREMENT_STORE_DRIVER_H
+
+#include <stddef.h>
+
+// Smallest erasable unit of the external flash on all supported boards
+#define MEASUREMENT_STORE_SECTOR_SIZE 4096U
+
+/**
+ * Returns the number of sectors reserved for the measurement store, or 0 if
+ * there is no suitable flash on the board.
+ */
+size_t measurement_store_driver_sector_count(void);
+
+int measurement_store_driver_read(size_t sector,
+                                  size_t offset,
+                                  void *out_data,
+                                  size_t out_data_len);
+int measurement_store_driver_write(size_t sector,
+                                   size_t offset,
+                                   const void *data,
+                                   size_t data_len);
+int measurement_store_driver_erase(size_t sector);
+
+#endif // MEASUREMENT_STORE_DRIVER_H
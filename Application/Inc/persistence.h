@@ -19,9 +19,41 @@
 
 #include <anjay/core.h>
 
+/**
+ * Clears the stored modules and, if enabled, the stored core state.
+ */
 void persistence_clear(void);
 int persistence_mod_restore(anjay_t *anjay);
 int persistence_mod_persist_if_required(anjay_t *anjay);
 
+#ifdef ANJAY_WITH_CORE_PERSISTENCE
+/**
+ * Creates the Anjay object, resuming the core state stored by
+ * @ref persistence_core_persist_and_delete, which includes the DTLS session
+ * and Connection ID, so that the client does not have to perform a full
+ * handshake after a reboot. The stored state is consumed, so that it is never
+ * resumed twice.
+ *
+ * Falls back to @c anjay_new() if there is no valid stored state.
+ */
+anjay_t *persistence_core_restore(const anjay_configuration_t *config);
+
+/**
+ * Stores the core state of @p anjay, i.e. its registrations, observations and
+ * DTLS sessions, and deletes it. The state refers to the Security, Server and
+ * attribute storage modules, so they have to be persisted as well for the
+ * observations to be resumed with their attributes.
+ *
+ * Called only before a Reboot requested through the Device object, see the
+ * README.
+ */
+int persistence_core_persist_and_delete(anjay_t *anjay);
+
+/**
+ * Clears the stored core state, e.g. after the server configuration changed.
+ */
+void persistence_core_clear(void);
+#endif // ANJAY_WITH_CORE_PERSISTENCE
+
 
 #endif // PERSISTENCE_H
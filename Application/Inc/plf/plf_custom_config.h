@@ -31,6 +31,49 @@
 #define BOARD_BUTTONS_THREAD_STACK_SIZE (256U)
 #define BOARD_BUTTONS_THREAD_PRIO osPriorityBelowNormal
 
+// Sensor reads (blocking I2C transactions) are done in this thread, below
+// LwM2M thread priority
+#define SENSOR_ACQUISITION_THREAD_STACK_SIZE (512U)
+#define SENSOR_ACQUISITION_THREAD_PRIO osPriorityLow
+// Sensors sampled at least that rarely are kept at their lowest output data
+// rate, and powered down while not sampled at all, see sensor_sampling.h
+#define SENSOR_POWER_LOW_POWER_MIN_PERIOD_S (10)
+
+// Sensor samples reported with LwM2M Send are batched, see lwm2m.h. A SenML
+// CBOR record takes about 20 bytes, so a full batch fits in a single message.
+#define LWM2M_SEND_BATCH_SAMPLE_PERIOD_S (30)
+#define LWM2M_SEND_BATCH_MAX_SAMPLES (48U)
+#define LWM2M_SEND_BATCH_MAX_DELAY_S (300)
+// Samples which cannot be sent are kept in external flash and sent in batches
+// of LWM2M_SEND_BATCH_MAX_SAMPLES once possible, see measurement_store.h; after
+// a failed Send, sending them is retried that often
+#define LWM2M_SEND_STORE_RETRY_S (60)
+
+// With USE_LOW_POWER, the client uses LwM2M queue mode with this lifetime, and
+// modem PSM is requested for idle periods of at least this long, see
+// power_coordinator.h
+#define LWM2M_QUEUE_MODE_LIFETIME_S (900)
+#define POWER_COORDINATOR_MIN_PSM_S (120)
+
+// Periodic wakeups are aligned to multiples of TIMER_SLOTS_PERIOD_MS; one-shot
+// timers are postponed to the next multiple if it is within
+// TIMER_SLOTS_SLACK_PERCENT of their delay, but not more than
+// TIMER_SLOTS_MAX_SLACK_MS later, see timer_slots.h
+#define TIMER_SLOTS_PERIOD_MS (1000U)
+#define TIMER_SLOTS_SLACK_PERCENT (10U)
+#define TIMER_SLOTS_MAX_SLACK_MS (1000U)
+
+// Period of the MCU sleep residency report in the logs
+#define TICKLESS_IDLE_REPORT_PERIOD_S (300)
+
+// Period of the avs_malloc() pool and per-module usage report in the logs, see
+// pool_allocator.h
+#define POOL_ALLOCATOR_REPORT_PERIOD_S (3600)
+
+// Period over which the CPU usage of each task is measured, see
+// task_stats_object.h
+#define TASK_STATS_SAMPLE_PERIOD_S (60)
+
 // Number of datacache event callbacks defined by application
 #define APPLICATION_DATACACHE_NB 1
 
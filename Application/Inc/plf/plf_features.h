@@ -50,6 +50,16 @@ extern "C" {
 #define USE_COM_SOCKETS           (1)
 #endif /* !defined USE_COM_SOCKETS */
 
+/* Online (transparent) mode for modem sockets
+ * When set to 1, a TCP socket configured with com_setsockopt(COM_SO_TRANSPARENT) before its connection
+ * exchanges its payload as a raw byte stream on a dedicated IPC stream channel instead of an AT exchange
+ * per chunk. Only one socket at a time can be online; the modem driver has to support it (BG96),
+ * otherwise the socket falls back to command mode.
+ * Only meaningful with USE_SOCKETS_TYPE == USE_SOCKETS_MODEM. */
+#if !defined USE_SOCKETS_ONLINE_MODE
+#define USE_SOCKETS_ONLINE_MODE   (0)  /* 0: not included, 1: included */
+#endif /* !defined USE_SOCKETS_ONLINE_MODE */
+
 /* ===================================== */
 /* END - Cellular data mode              */
 /* ===================================== */
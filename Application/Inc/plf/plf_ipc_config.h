@@ -44,7 +44,13 @@ extern "C" {
 /* IPC tuning parameters */
 #if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM)
 /* SOCKET MODE (IP stack in the modem) */
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+/* online sockets use a stream channel for their payload */
+#define IPC_USE_STREAM_MODE (1U)
+#define IPC_RXBUF_STREAM_MAXSIZE  ((uint16_t) IPC_RXBUF_MAXSIZE) /* maximum size of stream queue (if used) */
+#else
 #define IPC_USE_STREAM_MODE (0U)
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
 #else
 /*  STREAM MODE (IP stack in MCU) */
 #define IPC_USE_STREAM_MODE (1U)
@@ -28,6 +28,7 @@ extern "C" {
 /*cstat -MISRAC2012-* */
 #include "cmsis_os.h"
 /*cstat +MISRAC2012-* */
+#include "timer_slots.h"
 
 /* Exported constants --------------------------------------------------------*/
 
@@ -41,6 +42,13 @@ extern "C" {
 #define RTOSAL_FREE                    vPortFree
 #endif /* !defined RTOSAL_FREE */
 
+/* Configure RTOSAL timer start service */
+/* Timers of the cellular middleware are aligned to the wakeup slots shared
+ * with the application, see timer_slots.h */
+#if !defined RTOSAL_TIMER_START
+#define RTOSAL_TIMER_START             timer_slots_timer_start
+#endif /* !defined RTOSAL_TIMER_START */
+
 /* Configure RTOSAL stack type size value */
 /* Cellular thread stack sizes in plf_thread_config.h are expressed in dwords.
  * According to RTOS thread stack allocation implementation,
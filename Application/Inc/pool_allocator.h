@@ -0,0 +1,98 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POOL_ALLOCATOR_H
+#define POOL_ALLOCATOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * avs_malloc() and friends are implemented on top of fixed size-class pools
+ * for the small, short-lived allocations made by Anjay, avs_coap, avs_net and
+ * mbedTLS, so that they do not fragment the C library heap. Requests larger
+ * than the largest class, or made when its pool is exhausted, fall back to
+ * malloc().
+ *
+ * avs_malloc() does not know its caller, so allocations are accounted to the
+ * module tagged for the calling thread, see
+ * @ref pool_allocator_tag_current_thread. mbedTLS allocations are accounted
+ * separately, as its allocator is set to this one by @ref pool_allocator_init.
+ */
+
+typedef enum {
+    POOL_ALLOCATOR_TAG_APPLICATION,
+    // Anjay, avs_coap and avs_net, all running in the LwM2M thread
+    POOL_ALLOCATOR_TAG_LWM2M,
+    POOL_ALLOCATOR_TAG_TLS,
+    POOL_ALLOCATOR_TAGS_COUNT
+} pool_allocator_tag_t;
+
+typedef struct {
+    // Bytes currently held, including the pool block or heap header overhead
+    size_t bytes;
+    // Since boot, or since the last pool_allocator_reset_high_water()
+    size_t bytes_high_water;
+    // Allocations currently held
+    uint32_t allocations;
+    uint32_t failures;
+} pool_allocator_tag_stats_t;
+
+typedef struct {
+    uint16_t block_size;
+    uint16_t block_count;
+    uint16_t used;
+    uint16_t used_high_water;
+    // Requests of this class served from the heap because the pool was full
+    uint32_t overflows;
+} pool_allocator_pool_stats_t;
+
+/**
+ * Makes mbedTLS allocate through the pools. Must be called before any TLS
+ * context is created.
+ */
+void pool_allocator_init(void);
+
+/**
+ * Accounts further allocations made by the calling thread to @p tag. Threads
+ * which are not tagged are accounted to POOL_ALLOCATOR_TAG_APPLICATION.
+ */
+void pool_allocator_tag_current_thread(pool_allocator_tag_t tag);
+
+void pool_allocator_get_tag_stats(pool_allocator_tag_t tag,
+                                  pool_allocator_tag_stats_t *out_stats);
+
+/**
+ * Restarts tracking the high-water mark of @p tag from its current usage,
+ * e.g. to measure the peak of a single phase of operation.
+ */
+void pool_allocator_reset_high_water(pool_allocator_tag_t tag);
+
+/**
+ * @returns Number of pools, i.e. the valid range of @p index of
+ *          @ref pool_allocator_get_pool_stats.
+ */
+size_t pool_allocator_pools_count(void);
+
+void pool_allocator_get_pool_stats(size_t index,
+                                   pool_allocator_pool_stats_t *out_stats);
+
+/**
+ * Logs the statistics of all tags and pools.
+ */
+void pool_allocator_log_stats(void);
+
+#endif // POOL_ALLOCATOR_H
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWER_COORDINATOR_H
+#define POWER_COORDINATOR_H
+
+#include <anjay/core.h>
+
+#include "plf_config.h"
+
+/**
+ * Power coordinator lets the modem sleep together with the LwM2M client.
+ *
+ * With USE_LOW_POWER, the client uses LwM2M queue mode, so Anjay closes its
+ * sockets once an exchange is over, and the socket layer puts the modem in
+ * data idle as soon as no socket is open. The coordinator then measures the gap
+ * until the next LwM2M client job with anjay_sched_time_to_next() and sizes
+ * the modem low power mode accordingly: gaps shorter than
+ * POWER_COORDINATOR_MIN_PSM_S only use data idle, longer ones use PSM with a
+ * requested periodic TAU (T3412) just above the gap, so that the network does
+ * not wake the modem before the client needs it.
+ *
+ * The new power configuration is requested when the modem is awake again, at
+ * the next exchange, since it is negotiated with the network anyway.
+ */
+
+#if (USE_LOW_POWER == 1)
+/**
+ * Updates the coordinator state. Has to be called periodically from a job of
+ * the LwM2M client scheduler, before that job reschedules itself, so that the
+ * job does not count as a pending deadline.
+ */
+void power_coordinator_update(anjay_t *anjay);
+#endif // (USE_LOW_POWER == 1)
+
+#endif // POWER_COORDINATOR_H
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef PUSH_BUTTON_OBJECT_H
+#define PUSH_BUTTON_OBJECT_H
+
+#include <anjay/anjay.h>
+
+#include "board_buttons.h"
+
+/**
+ * Installs the IPSO Push Button object (/3347) for the board button. Meant for
+ * boards on which the button is not reported by the joystick object.
+ */
+int push_button_object_install(anjay_t *anjay);
+
+/**
+ * Reports an edge of the board button. Must be called from the LwM2M thread,
+ * for each event in order, so that every press is counted.
+ */
+void push_button_object_handle_event(anjay_t *anjay,
+                                     const board_buttons_event_t *event);
+
+#endif // PUSH_BUTTON_OBJECT_H
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef RUN_TIME_COUNTER_H
+#define RUN_TIME_COUNTER_H
+
+#include <stdint.h>
+
+/**
+ * Time base of the FreeRTOS run time statistics (configGENERATE_RUN_TIME_STATS
+ * is 1, see FreeRTOSConfig.h), implemented for each board in app_compat.
+ *
+ * The general purpose 32-bit timer TIM2 free-runs at RUN_TIME_COUNTER_HZ
+ * without any interrupt, so that the kernel pays a single register read per
+ * context switch. Unlike the DWT cycle counter, it keeps counting while the
+ * core is in Sleep mode (see tickless_idle.h), so that the time spent sleeping
+ * is accounted to the idle task. It wraps around after about 11 hours, which
+ * only matters to the users of the statistics if they sample them less often.
+ */
+
+#define RUN_TIME_COUNTER_HZ 100000U
+
+/**
+ * Starts the counter. Called by the kernel when the scheduler is started.
+ */
+void run_time_counter_init(void);
+
+/**
+ * Returns the current value of the counter, in 1 / RUN_TIME_COUNTER_HZ units.
+ */
+uint32_t run_time_counter_get(void);
+
+#endif // RUN_TIME_COUNTER_H
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SENSOR_ACQUISITION_H
+#define SENSOR_ACQUISITION_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sensor_drivers/sensor_power.h"
+
+/**
+ * Sensor acquisition runs the (blocking) sensor driver reads in a dedicated
+ * low priority task, so that the LwM2M thread only ever copies the latest
+ * values from memory.
+ *
+ * Values are published through a double-buffered snapshot: the acquisition
+ * task fills the buffer which is not the current one, then switches the
+ * sequence number. A reader never waits for the writer, it only retries if
+ * the buffer it copied got overwritten meanwhile, which requires two complete
+ * acquisitions by the lower priority task.
+ */
+
+#define SENSOR_ACQUISITION_MAX_VALUES 3
+
+typedef struct {
+    float values[SENSOR_ACQUISITION_MAX_VALUES];
+} sensor_acquisition_sample_t;
+
+/**
+ * Reads the sensor, called from the acquisition task.
+ *
+ * @returns 0 on success, negative value otherwise.
+ */
+typedef int sensor_acquisition_read_t(const void *arg,
+                                      sensor_acquisition_sample_t *out_sample);
+
+/**
+ * Puts the sensor in a power state, called from the acquisition task.
+ *
+ * @returns 0 on success, negative value otherwise.
+ */
+typedef int sensor_acquisition_set_power_t(const void *arg,
+                                           sensor_power_state_t state,
+                                           float odr_hz);
+
+typedef struct {
+    sensor_acquisition_read_t *read;
+    sensor_acquisition_set_power_t *set_power;
+    const void *arg;
+
+    // Private fields, initialized by sensor_acquisition_register()
+    atomic_bool requested;
+    // Encoded power state requested by the readers, and the one last applied
+    // by the acquisition task
+    atomic_uint_fast32_t power_request;
+    uint32_t power_applied;
+    // Number of samples published so far; buf[seq % 2] is the latest one
+    atomic_uint_fast32_t seq;
+    sensor_acquisition_sample_t buf[2];
+} sensor_acquisition_source_t;
+
+/**
+ * Work run by the acquisition task on demand, e.g. draining a hardware FIFO
+ * when its watermark interrupt fires.
+ */
+typedef void sensor_acquisition_work_handler_t(void);
+
+typedef struct {
+    sensor_acquisition_work_handler_t *handler;
+
+    // Private field, initialized by sensor_acquisition_register_work()
+    atomic_bool scheduled;
+} sensor_acquisition_work_t;
+
+/**
+ * Registers a source. Its first sample is acquired synchronously, in the
+ * calling thread, so that it has a value as soon as it is registered.
+ *
+ * @param set_power Optional, NULL if the sensor has no power control.
+ *
+ * @returns 0 on success, negative value if there is no room for the source.
+ */
+int sensor_acquisition_register(sensor_acquisition_source_t *source,
+                                sensor_acquisition_read_t *read,
+                                sensor_acquisition_set_power_t *set_power,
+                                const void *arg);
+
+/**
+ * Asks the acquisition task for a new sample of @p source. Never blocks.
+ */
+void sensor_acquisition_request(sensor_acquisition_source_t *source);
+
+/**
+ * Asks the acquisition task to put @p source in the given power state, before
+ * acquiring any further samples. Never blocks, and does nothing if the same
+ * state has already been requested.
+ */
+void sensor_acquisition_set_power(sensor_acquisition_source_t *source,
+                                  sensor_power_state_t state,
+                                  float odr_hz);
+
+/**
+ * Copies the latest sample of @p source. Never blocks.
+ *
+ * @returns 0 on success, negative value if no sample has been acquired yet.
+ */
+int sensor_acquisition_get(sensor_acquisition_source_t *source,
+                           sensor_acquisition_sample_t *out_sample);
+
+/**
+ * Checks whether a sample has been published since the previous call with the
+ * same @p last_seq.
+ *
+ * @param last_seq Sequence number seen by the caller, updated by this function.
+ */
+bool sensor_acquisition_has_new_sample(sensor_acquisition_source_t *source,
+                                       uint32_t *last_seq);
+
+/**
+ * Registers a work item, which is run by the acquisition task whenever it is
+ * scheduled with @ref sensor_acquisition_schedule_work.
+ *
+ * @returns 0 on success, negative value if there is no room for the work.
+ */
+int sensor_acquisition_register_work(
+        sensor_acquisition_work_t *work,
+        sensor_acquisition_work_handler_t *handler);
+
+/**
+ * Schedules @p work to be run by the acquisition task. Never blocks, may be
+ * called from an interrupt handler.
+ */
+void sensor_acquisition_schedule_work(sensor_acquisition_work_t *work);
+
+void sensor_acquisition_init(void);
+
+void sensor_acquisition_start(void);
+
+#endif // SENSOR_ACQUISITION_H
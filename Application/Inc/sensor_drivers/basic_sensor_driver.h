@@ -21,9 +21,16 @@
 #include "sensor.h"
 #endif
 
+#include "sensor_power.h"
+
 typedef struct {
     int (*init)(void);
     int (*read)(float *);
+    /**
+     * Optional. Puts the initialized sensor in the given power state; it is
+     * left active at its default output data rate otherwise.
+     */
+    int (*set_power_state)(sensor_power_state_t state, float odr_hz);
 } basic_sensor_driver_t;
 
 #endif // BASIC_SENSOR_DRIVER_H
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MOTION_FIFO_H
+#define MOTION_FIFO_H
+
+#include <stdint.h>
+
+#include "three_axis_sensor_driver.h"
+
+/**
+ * Batched acquisition of the accelerometer and gyrometer of a sensor with an
+ * on-chip FIFO. The sensor pushes samples into the FIFO at a fixed batch data
+ * rate, and the whole batch is drained with a single burst read by the sensor
+ * acquisition task whenever the FIFO watermark interrupt fires. Statistics are
+ * accumulated from every sample until they are read as a window.
+ *
+ * Implemented by boards which define BSP_MOTION_FIFO_INT_PIN.
+ */
+
+typedef enum {
+    MOTION_FIFO_ACCELEROMETER,
+    MOTION_FIFO_GYROMETER,
+    MOTION_FIFO_SENSORS_COUNT
+} motion_fifo_sensor_t;
+
+/**
+ * Raw statistics of the samples drained from the FIFO, in sensor LSBs.
+ */
+typedef struct {
+    int16_t min[3];
+    int16_t max[3];
+    int64_t sum[3];
+    uint32_t count;
+} motion_fifo_stats_t;
+
+/**
+ * Starts batching samples of an already enabled sensor. The FIFO and its
+ * interrupt are configured on the first call. Does nothing if the sensor is
+ * already batched.
+ *
+ * @param sensor     Sensor to batch.
+ * @param bsp_handle Handle of the sensor returned by the BSP, if the BSP uses
+ *                   handles, NULL otherwise.
+ *
+ * @returns 0 on success, negative value otherwise.
+ */
+int motion_fifo_enable(motion_fifo_sensor_t sensor, void *bsp_handle);
+
+/**
+ * Stops batching samples of @p sensor, before it is powered down. Samples of
+ * the other sensor are kept batched.
+ *
+ * @returns 0 on success, negative value otherwise.
+ */
+int motion_fifo_disable(motion_fifo_sensor_t sensor);
+
+/**
+ * Drains the FIFO, then reads statistics of all samples of @p sensor batched
+ * since the previous call, in the units of the BSP (mg or mdps).
+ *
+ * @returns 0 on success, negative value if the sensor is not batched or no
+ *          sample has been batched since the previous call.
+ */
+int motion_fifo_read_window(motion_fifo_sensor_t sensor,
+                            three_axis_sensor_window_t *out_window);
+
+/**
+ * Called from the interrupt handler of BSP_MOTION_FIFO_INT_PIN.
+ */
+void motion_fifo_irq_handler(void);
+
+static inline void motion_fifo_stats_add(motion_fifo_stats_t *stats,
+                                         const int16_t raw[3]) {
+    for (int i = 0; i < 3; i++) {
+        if (!stats->count || raw[i] < stats->min[i]) {
+            stats->min[i] = raw[i];
+        }
+        if (!stats->count || raw[i] > stats->max[i]) {
+            stats->max[i] = raw[i];
+        }
+        stats->sum[i] += raw[i];
+    }
+    stats->count++;
+}
+
+/**
+ * Converts @p stats to a window using @p sensitivity (units per LSB), then
+ * resets them.
+ */
+static inline int
+motion_fifo_stats_pop(motion_fifo_stats_t *stats,
+                      float sensitivity,
+                      three_axis_sensor_window_t *out_window) {
+    if (!stats->count) {
+        return -1;
+    }
+
+    float avg_coeff = sensitivity / (float) stats->count;
+    *out_window = (three_axis_sensor_window_t) {
+        .min = {
+            .x = (float) stats->min[0] * sensitivity,
+            .y = (float) stats->min[1] * sensitivity,
+            .z = (float) stats->min[2] * sensitivity
+        },
+        .max = {
+            .x = (float) stats->max[0] * sensitivity,
+            .y = (float) stats->max[1] * sensitivity,
+            .z = (float) stats->max[2] * sensitivity
+        },
+        .avg = {
+            .x = (float) stats->sum[0] * avg_coeff,
+            .y = (float) stats->sum[1] * avg_coeff,
+            .z = (float) stats->sum[2] * avg_coeff
+        },
+        .count = stats->count
+    };
+    *stats = (motion_fifo_stats_t) { 0 };
+    return 0;
+}
+
+#endif // MOTION_FIFO_H
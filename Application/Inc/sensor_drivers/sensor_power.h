@@ -0,0 +1,42 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SENSOR_POWER_H
+#define SENSOR_POWER_H
+
+typedef enum {
+    // Powered down, not sampling at all
+    SENSOR_POWER_OFF,
+    // Sampling at the lowest output data rate the sensor supports
+    SENSOR_POWER_LOW_POWER,
+    // Sampling at the requested output data rate
+    SENSOR_POWER_ACTIVE
+} sensor_power_state_t;
+
+/**
+ * Output data rate to configure in the given power state. 0 stands for the
+ * lowest rate, as the BSPs round the requested rate up to a supported one.
+ *
+ * Sensors which share a chip, e.g. a thermometer and a hygrometer, may also
+ * share the output data rate, in which case the last one set wins.
+ */
+static inline float sensor_power_odr_hz(sensor_power_state_t state,
+                                        float odr_hz) {
+    return state == SENSOR_POWER_ACTIVE ? odr_hz : 0.0f;
+}
+
+#endif // SENSOR_POWER_H
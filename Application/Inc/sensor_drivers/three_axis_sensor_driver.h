@@ -17,7 +17,10 @@
 #ifndef THREE_AXIS_SENSOR_DRIVER_H
 #define THREE_AXIS_SENSOR_DRIVER_H
 
+#include <stdint.h>
+
 #include "main.h"
+#include "sensor_power.h"
 
 #define G_TO_MS2 9.80665
 
@@ -27,9 +30,31 @@ typedef struct {
     float z;
 } three_axis_sensor_values_t;
 
+/**
+ * Statistics of all samples acquired during a window.
+ */
+typedef struct {
+    three_axis_sensor_values_t min;
+    three_axis_sensor_values_t max;
+    three_axis_sensor_values_t avg;
+    uint32_t count;
+} three_axis_sensor_window_t;
+
 typedef struct {
     int (*init)(void);
     int (*read)(three_axis_sensor_values_t *);
+    /**
+     * Optional. Reads statistics of all samples batched by the sensor since
+     * the previous call and starts a new window. Fails if there are no such
+     * samples, in which case @c read is used instead.
+     */
+    int (*read_window)(three_axis_sensor_window_t *);
+    /**
+     * Optional. Puts the initialized sensor in the given power state; it is
+     * left active at its default output data rate otherwise. Sensors batched
+     * in a FIFO keep their batch data rate while not off.
+     */
+    int (*set_power_state)(sensor_power_state_t state, float odr_hz);
 } three_axis_sensor_driver_t;
 
 static inline three_axis_sensor_values_t
@@ -46,4 +71,20 @@ three_axis_sensor_get_values(const bsp_axes_t *axes) {
     return three_axis_sensor_get_values_scaled(axes, 1.0f);
 }
 
+static inline three_axis_sensor_values_t
+three_axis_sensor_scale_values(three_axis_sensor_values_t values, float coeff) {
+    return (three_axis_sensor_values_t) {
+        .x = values.x * coeff,
+        .y = values.y * coeff,
+        .z = values.z * coeff
+    };
+}
+
+static inline void three_axis_sensor_scale_window(
+        three_axis_sensor_window_t *window, float coeff) {
+    window->min = three_axis_sensor_scale_values(window->min, coeff);
+    window->max = three_axis_sensor_scale_values(window->max, coeff);
+    window->avg = three_axis_sensor_scale_values(window->avg, coeff);
+}
+
 #endif // THREE_AXIS_SENSOR_DRIVER_H
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SENSOR_SAMPLING_H
+#define SENSOR_SAMPLING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <anjay/anjay.h>
+#include <avsystem/commons/avs_time.h>
+
+#include "plf_config.h"
+#include "sensor_drivers/sensor_power.h"
+
+/**
+ * Background sampling period of sensors whose samples are reported with LwM2M
+ * Send even if they are not observed.
+ */
+#ifdef ANJAY_WITH_SEND
+#define SENSOR_SAMPLING_BACKGROUND_PERIOD_S LWM2M_SEND_BATCH_SAMPLE_PERIOD_S
+#else // ANJAY_WITH_SEND
+#define SENSOR_SAMPLING_BACKGROUND_PERIOD_S 0
+#endif // ANJAY_WITH_SEND
+
+/**
+ * Sampling state of a single sensor instance.
+ *
+ * @ref SENSOR_SAMPLING_INITIALIZER has to be used as the initial value.
+ */
+typedef struct {
+    /**
+     * Period used when the sensor is observed without any Minimum Period
+     * attribute, in seconds.
+     */
+    int32_t default_period_s;
+    /**
+     * Period used when the sensor is not observed, in seconds, or 0 if such a
+     * sensor is not sampled at all.
+     */
+    int32_t background_period_s;
+    /**
+     * Whether the sensor is being sampled, i.e. @c next_sample is meaningful.
+     */
+    bool scheduled;
+    /**
+     * Time of the next sample.
+     */
+    avs_time_monotonic_t next_sample;
+    /**
+     * Sampling period determined by the last call to
+     * @ref sensor_sampling_is_due, in seconds, or a negative value if the
+     * sensor is not sampled.
+     */
+    int32_t period_s;
+} sensor_sampling_t;
+
+#define SENSOR_SAMPLING_INITIALIZER(DefaultPeriodS, BackgroundPeriodS) \
+    {                                                                  \
+        .default_period_s = (DefaultPeriodS),                          \
+        .background_period_s = (BackgroundPeriodS),                    \
+        .scheduled = false,                                            \
+        .period_s = -1                                                 \
+    }
+
+/**
+ * Checks whether a sensor instance has to be sampled now, and if so, plans the
+ * next sample.
+ *
+ * The sensor is sampled if at least one of @p rids is observed (directly, or
+ * through its Object or Object Instance), or if @c background_period_s is set.
+ * The sampling period is the tightest one required by active observations:
+ * the smallest Minimum Period (pmin) attribute, or @c default_period_s if pmin
+ * is not set, bounded by the smallest Maximum Evaluation Period (epmax)
+ * attribute, and by @c background_period_s. Samples are aligned to multiples
+ * of the period on the monotonic clock, so that co-reported sensors are sampled
+ * in the same cycle. Actual resolution is limited by the period of the caller.
+ *
+ * @param anjay       Anjay object to query for observation status.
+ * @param sampling    Sampling state of the sensor instance.
+ * @param oid         Object ID of the sensor.
+ * @param iid         Instance ID of the sensor.
+ * @param rids        Resources whose observation requires a sample.
+ * @param rids_count  Number of elements in @p rids.
+ *
+ * @returns true if the sensor has to be sampled now, false otherwise.
+ */
+bool sensor_sampling_is_due(anjay_t *anjay,
+                            sensor_sampling_t *sampling,
+                            anjay_oid_t oid,
+                            anjay_iid_t iid,
+                            const anjay_rid_t *rids,
+                            size_t rids_count);
+
+/**
+ * Power state a sensor instance needs for its current sampling period, as
+ * determined by the last call to @ref sensor_sampling_is_due: off if it is not
+ * sampled, at the lowest output data rate if it is sampled at least every
+ * @c SENSOR_POWER_LOW_POWER_MIN_PERIOD_S seconds, and active at one sample per
+ * period otherwise.
+ *
+ * @param sampling    Sampling state of the sensor instance.
+ * @param out_odr_hz  Set to the output data rate required in the returned
+ *                    state.
+ */
+sensor_power_state_t
+sensor_sampling_power_state(const sensor_sampling_t *sampling,
+                            float *out_odr_hz);
+
+#endif // SENSOR_SAMPLING_H
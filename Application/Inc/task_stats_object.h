@@ -0,0 +1,33 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef TASK_STATS_OBJECT_H
+#define TASK_STATS_OBJECT_H
+
+#include <anjay/anjay.h>
+
+int task_stats_object_install(anjay_t *anjay);
+
+/**
+ * Samples the run time statistics and stack high water marks of all tasks, and
+ * notifies the resources that changed since the previous call. The CPU usage
+ * of each task is measured over the time between the two calls, which is meant
+ * to be TASK_STATS_SAMPLE_PERIOD_S.
+ */
+void task_stats_object_update(anjay_t *anjay);
+
+#endif // TASK_STATS_OBJECT_H
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef TICKLESS_IDLE_H
+#define TICKLESS_IDLE_H
+
+#include <stdint.h>
+
+/**
+ * Tickless idle suppresses the RTOS tick interrupt while no task is ready to
+ * run, and keeps time with the low power timer LPTIM1 instead, so that the MCU
+ * stays in Sleep mode until the next timer expiry or peripheral interrupt.
+ *
+ * Stop modes are not used, as the modem UART and its DMA have to keep running.
+ * Implemented for each board in app_compat, as vPortSuppressTicksAndSleep()
+ * (configUSE_TICKLESS_IDLE is 2, see FreeRTOSConfig.h).
+ */
+
+typedef struct {
+    /**
+     * Time spent in Sleep mode with the tick suppressed since boot, in RTOS
+     * ticks.
+     */
+    uint64_t sleep_ticks;
+    /**
+     * Number of times the MCU entered Sleep mode with the tick suppressed.
+     */
+    uint32_t sleeps;
+} tickless_idle_stats_t;
+
+/**
+ * Configures LPTIM1. The tick is not suppressed until this is called.
+ */
+void tickless_idle_init(void);
+
+/**
+ * Returns the statistics since boot. The residency in Sleep mode is
+ * @c sleep_ticks divided by the current tick count.
+ */
+tickless_idle_stats_t tickless_idle_get_stats(void);
+
+#endif // TICKLESS_IDLE_H
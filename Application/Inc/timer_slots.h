@@ -0,0 +1,70 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef TIMER_SLOTS_H
+#define TIMER_SLOTS_H
+
+#include <stdint.h>
+
+#include <cmsis_os.h>
+
+#include "plf_config.h"
+
+/**
+ * Timer slots gather the periodic wakeups of the firmware, so that the MCU
+ * wakes up once per slot instead of once per timer and can stay in tickless
+ * idle in between.
+ *
+ * Slots are multiples of TIMER_SLOTS_PERIOD_MS on the RTOS tick counter.
+ * Periodic work is phased so that it becomes due at slot boundaries, and
+ * one-shot timers are postponed to the next boundary if it is within their
+ * slack.
+ */
+
+/**
+ * Returns the delay after which a periodic job which has just run has to run
+ * again, so that its occurrences fall on slot boundaries.
+ *
+ * @param period_ms Period of the job, preferably a multiple of
+ *                  TIMER_SLOTS_PERIOD_MS.
+ */
+uint32_t timer_slots_periodic_delay_ms(uint32_t period_ms);
+
+/**
+ * Returns @p delay_ms extended up to the next slot boundary, if it is at most
+ * @p slack_ms later, or @p delay_ms otherwise.
+ */
+uint32_t timer_slots_delay_ms(uint32_t delay_ms, uint32_t slack_ms);
+
+/**
+ * Returns the slack allowed for a one-shot timer expiring after @p delay_ms:
+ * TIMER_SLOTS_SLACK_PERCENT of the delay, at most TIMER_SLOTS_MAX_SLACK_MS.
+ */
+uint32_t timer_slots_default_slack_ms(uint32_t delay_ms);
+
+/**
+ * Starts an RTOS timer aligned to the slots. Used by the RTOS abstraction layer
+ * of the cellular middleware as RTOSAL_TIMER_START, see plf_rtosal_config.h.
+ *
+ * One-shot timers expire after timer_slots_delay_ms() with the default slack.
+ * The first expiry of a periodic timer is moved to a slot boundary, so that all
+ * of its expiries fall on them if the period is a multiple of
+ * TIMER_SLOTS_PERIOD_MS.
+ */
+osStatus timer_slots_timer_start(osTimerId timer_id, uint32_t millisec);
+
+#endif // TIMER_SLOTS_H
@@ -44,8 +44,13 @@
 #include "application.h"
 #include "board_buttons.h"
 #include "config_persistence.h"
+#include "ext_ram.h"
+#include "heap_regions.h"
 #include "lwm2m.h"
 #include "menu.h"
+#include "pool_allocator.h"
+#include "sensor_acquisition.h"
+#include "tickless_idle.h"
 
 static void configure_modem(void) {
     dc_cellular_params_t cellular_params;
@@ -65,11 +70,15 @@ static void configure_modem(void) {
 }
 
 static void utilities_init(void) {
+    (void) ext_ram_init();
     (void) board_buttons_init();
+    sensor_acquisition_init();
+    tickless_idle_init();
 }
 
 static void utilities_start(void) {
     (void) board_buttons_start();
+    sensor_acquisition_start();
 }
 
 static void
@@ -80,9 +89,14 @@ log_handler(avs_log_level_t level, const char *module, const char *message) {
 }
 
 void application_init(void) {
+    // Before any kernel object is created
+    heap_regions_init();
+    // Before anything allocates through mbedTLS
+    pool_allocator_init();
     menu_init();
 
     avs_log_set_handler(log_handler);
+    heap_regions_log_stats();
     /* RandomNumberGenerator );*/
     srand(osKernelSysTick());
 
@@ -36,37 +36,75 @@
 /* Includes ------------------------------------------------------------------*/
 #include "plf_config.h"
 
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdint.h>
 
 #include <cmsis_os.h>
 
+#include <avsystem/commons/avs_time.h>
+
 #include <dc_common.h>
 #include <error_handler.h>
 
 #include "board_buttons.h"
-#include "joystick_object.h"
 
 /* Private typedef -----------------------------------------------------------*/
+typedef struct {
+    GPIO_TypeDef *port;
+    uint16_t pin;
+} board_buttons_gpio_t;
+
+/* Debounce state of an input */
+typedef struct {
+    osTimerId timer;
+    /* Debounced state, as of the last event */
+    atomic_bool pressed;
+    /* Edges are ignored until the debounce timer expires */
+    bool settling;
+} board_buttons_state_t;
+
+/* Queued event, timestamped with the kernel tick */
+typedef struct {
+    board_buttons_input_t input;
+    bool pressed;
+    uint32_t tick;
+} board_buttons_edge_t;
+
 /* Private defines -----------------------------------------------------------*/
 /* Private macros ------------------------------------------------------------*/
-#define BOARD_BUTTONS_DEBOUNCE_TIMEOUT (200U) /* in millisec */
+#define BOARD_BUTTONS_DEBOUNCE_TIMEOUT (30U) /* in millisec */
 #define BOARD_BUTTONS_MSG_QUEUE_SIZE (uint32_t)(8)
+/* Power of 2, so that the indices may wrap */
+#define BOARD_BUTTONS_EVENTS_SIZE (32U)
 
 /* Private variables ---------------------------------------------------------*/
 static osMessageQId board_buttons_msg_queue;
 static board_buttons_t board_buttons_sel;
 
-static osTimerId DebounceTimerHandle;
-static __IO uint8_t debounce_ongoing = 0U;
+/* JOY_RIGHT is not listed, as EXTI line 11 is taken over by the IKS01A2
+ * FIFO interrupt (see motion_fifo.c); the joystick object polls it */
+static const board_buttons_gpio_t board_buttons_gpios[] = {
+    [BOARD_BUTTONS_BUTTON] = { BSP_BUTTON_PORT, BSP_BUTTON },
+#ifdef BSP_JOYSTICK_PRESENT
+    [BOARD_BUTTONS_JOY_UP] = { JOY_UP_GPIO_Port, JOY_UP_Pin },
+    [BOARD_BUTTONS_JOY_DOWN] = { JOY_DOWN_GPIO_Port, JOY_DOWN_Pin },
+    [BOARD_BUTTONS_JOY_LEFT] = { JOY_LEFT_GPIO_Port, JOY_LEFT_Pin },
+#endif /* BSP_JOYSTICK_PRESENT */
+};
+
+static board_buttons_state_t board_buttons_states[BOARD_BUTTONS_INPUTS_COUNT];
 
-static bool sel_pressed;
+/* Written from the EXTI interrupts and from the debounce timers with the EXTI
+ * interrupts masked, read by a single thread */
+static board_buttons_edge_t board_buttons_events[BOARD_BUTTONS_EVENTS_SIZE];
+static atomic_uint_fast32_t board_buttons_events_head;
+static atomic_uint_fast32_t board_buttons_events_tail;
 
 /* Global variables ----------------------------------------------------------*/
 dc_com_res_id_t DC_BOARD_BUTTONS_SEL = DC_COM_INVALID_ENTRY;
 
 /* Private function prototypes -----------------------------------------------*/
-static void board_buttons_post_event_debounce(dc_com_event_id_t event_id);
 static void board_buttons_debounce_timer_callback(void const *argument);
 static void board_buttons_thread(void const *argument);
 
@@ -90,54 +128,148 @@ void board_buttons_thread(void const *argument) {
     }
 }
 
-static void buttons_callback(dc_com_event_id_t dc_event_id,
-                             const void *user_arg) {
-    (void) user_arg;
+static bool board_buttons_read(board_buttons_input_t input) {
+    return HAL_GPIO_ReadPin(board_buttons_gpios[input].port,
+                            board_buttons_gpios[input].pin)
+           == GPIO_PIN_SET;
+}
 
-    if (dc_event_id == DC_BOARD_BUTTONS_SEL && sel_pressed) {
-        joystick_object_increment_counter();
+/**
+ * @brief  queues an event, with the EXTI interrupts masked
+ * @param  input               input
+ * @param  pressed             new debounced state
+ * @retval bool                false if the queue is full
+ */
+static bool board_buttons_push_event(board_buttons_input_t input,
+                                     bool pressed) {
+    uint_fast32_t head = atomic_load_explicit(&board_buttons_events_head,
+                                              memory_order_relaxed);
+    uint_fast32_t tail = atomic_load_explicit(&board_buttons_events_tail,
+                                              memory_order_acquire);
+    if (head - tail >= BOARD_BUTTONS_EVENTS_SIZE) {
+        return false;
     }
+    board_buttons_events[head % BOARD_BUTTONS_EVENTS_SIZE] =
+            (board_buttons_edge_t) {
+                .input = input,
+                .pressed = pressed,
+                .tick = osKernelSysTick()
+            };
+    atomic_store_explicit(&board_buttons_events_head, head + 1,
+                          memory_order_release);
+    return true;
 }
 
 /**
- * @brief  debounce timer management
- * @param  event_id            event id
- * @retval board_buttons_status_t    return status
+ * @brief  records a debounced edge, with the EXTI interrupts masked;
+ *         board_buttons_edge_post() has to be called afterwards
+ * @param  input               input
+ * @param  pressed             new debounced state
+ * @retval bool                false if the event could not be queued
  */
-static void board_buttons_debounce_timer_callback(void const *argument) {
-    (void) argument;
-    debounce_ongoing = 0U;
+static bool board_buttons_edge(board_buttons_input_t input, bool pressed) {
+    board_buttons_state_t *state = &board_buttons_states[input];
+
+    atomic_store(&state->pressed, pressed);
+    state->settling = true;
+    return board_buttons_push_event(input, pressed);
+}
+
+/**
+ * @brief  starts debouncing after an edge, and reports it to the Data Cache
+ * @param  input               input
+ * @param  queued              result of board_buttons_edge()
+ * @retval none
+ */
+static void board_buttons_edge_post(board_buttons_input_t input,
+                                    bool queued) {
+    (void) osTimerStart(board_buttons_states[input].timer,
+                        BOARD_BUTTONS_DEBOUNCE_TIMEOUT);
+    if (!queued
+            || (input == BOARD_BUTTONS_BUTTON
+                && osMessagePut(board_buttons_msg_queue,
+                                (uint32_t) DC_BOARD_BUTTONS_SEL, 0U)
+                           != osOK)) {
+        ERROR_Handler(DBG_CHAN_APPLICATION, 7, ERROR_WARNING);
+    }
 }
 
 /**
- * @brief  debounce event management
- * @param  event_id            event id
- * @retval board_buttons_status_t    return status
+ * @brief  debounce timer management: the input is sampled again once it has
+ *         settled, in case it changed back while edges were ignored
+ * @param  argument            input
+ * @retval none
  */
-static void board_buttons_post_event_debounce(dc_com_event_id_t event_id) {
-    /* post event to the queue only if no ongoing debounce
-     * limitation: all events with debounce are sharing same timer
-     */
-    if (debounce_ongoing == 0U) {
-        if (osMessagePut(board_buttons_msg_queue, (uint32_t) event_id, 0U)
-                != osOK) {
-            ERROR_Handler(DBG_CHAN_APPLICATION, 7, ERROR_WARNING);
-        } else {
-            (void) osTimerStart(DebounceTimerHandle,
-                                BOARD_BUTTONS_DEBOUNCE_TIMEOUT);
-            debounce_ongoing = 1U;
+static void board_buttons_debounce_timer_callback(void const *argument) {
+    board_buttons_input_t input = (board_buttons_input_t) (uintptr_t) argument;
+    board_buttons_state_t *state = &board_buttons_states[input];
+
+    taskENTER_CRITICAL();
+    bool pressed = board_buttons_read(input);
+    bool changed = (pressed != atomic_load(&state->pressed));
+    bool queued = false;
+    if (changed) {
+        queued = board_buttons_edge(input, pressed);
+    } else {
+        state->settling = false;
+    }
+    taskEXIT_CRITICAL();
+
+    if (changed) {
+        board_buttons_edge_post(input, queued);
+    }
+}
+
+bool board_buttons_irq_handler(uint16_t pin) {
+    for (int i = 0; i < BOARD_BUTTONS_INPUTS_COUNT; i++) {
+        if (board_buttons_gpios[i].pin != pin) {
+            continue;
         }
+
+        board_buttons_input_t input = (board_buttons_input_t) i;
+        board_buttons_state_t *state = &board_buttons_states[input];
+        /* Each input has its own debounce timer, so edges of other inputs
+         * are never lost; bounces are ignored until it expires */
+        bool pressed = board_buttons_read(input);
+        if (!state->settling && state->timer
+                && pressed != atomic_load(&state->pressed)) {
+            board_buttons_edge_post(input, board_buttons_edge(input, pressed));
+        }
+        return true;
     }
+    return false;
 }
 
-void board_button_joy_sel_press(void) {
-    sel_pressed = true;
-    board_buttons_post_event_debounce(DC_BOARD_BUTTONS_SEL);
+bool board_buttons_get_event(board_buttons_event_t *out_event) {
+    uint_fast32_t tail = atomic_load_explicit(&board_buttons_events_tail,
+                                              memory_order_relaxed);
+    uint_fast32_t head = atomic_load_explicit(&board_buttons_events_head,
+                                              memory_order_acquire);
+    if (tail == head) {
+        return false;
+    }
+    board_buttons_edge_t edge =
+            board_buttons_events[tail % BOARD_BUTTONS_EVENTS_SIZE];
+    atomic_store_explicit(&board_buttons_events_tail, tail + 1,
+                          memory_order_release);
+
+    /* The tick is converted to the monotonic clock here, as
+     * avs_time_monotonic_now() cannot be called from an interrupt */
+    uint32_t age_ticks = osKernelSysTick() - edge.tick;
+    *out_event = (board_buttons_event_t) {
+        .input = edge.input,
+        .pressed = edge.pressed,
+        .time = avs_time_monotonic_add(
+                avs_time_monotonic_now(),
+                avs_time_duration_from_scalar(
+                        -(int64_t) age_ticks * 1000 / osKernelSysTickFrequency,
+                        AVS_TIME_MS))
+    };
+    return true;
 }
 
-void board_button_joy_sel_release(void) {
-    sel_pressed = false;
-    board_buttons_post_event_debounce(DC_BOARD_BUTTONS_SEL);
+bool board_buttons_is_pressed(board_buttons_input_t input) {
+    return atomic_load(&board_buttons_states[input].pressed);
 }
 
 /**
@@ -146,11 +278,6 @@ void board_button_joy_sel_release(void) {
  * @retval board_buttons_status_t     return status
  */
 board_buttons_status_t board_buttons_init(void) {
-    /* definition and creation of DebounceTimer */
-    osTimerDef(DebounceTimer, board_buttons_debounce_timer_callback);
-    DebounceTimerHandle =
-            osTimerCreate(osTimer(DebounceTimer), osTimerOnce, NULL);
-
     /* queue creation */
     osMessageQDef(BOARD_BUTTONS_MSG_QUEUE, BOARD_BUTTONS_MSG_QUEUE_SIZE,
                   uint32_t);
@@ -161,7 +288,19 @@ board_buttons_status_t board_buttons_init(void) {
             dc_com_register_serv(&dc_com_db, (void *) &board_buttons_sel,
                                  (uint16_t) sizeof(board_buttons_t));
 
-    dc_com_register_gen_event_cb(&dc_com_db, buttons_callback, NULL);
+    atomic_init(&board_buttons_events_head, 0);
+    atomic_init(&board_buttons_events_tail, 0);
+
+    /* one debounce timer per input, so that near-simultaneous presses of
+     * different inputs do not collide; edges are handled once it exists */
+    osTimerDef(DebounceTimer, board_buttons_debounce_timer_callback);
+    for (int i = 0; i < BOARD_BUTTONS_INPUTS_COUNT; i++) {
+        atomic_init(&board_buttons_states[i].pressed,
+                    board_buttons_read((board_buttons_input_t) i));
+        board_buttons_states[i].timer =
+                osTimerCreate(osTimer(DebounceTimer), osTimerOnce,
+                              (void *) (uintptr_t) i);
+    }
 
     return BOARD_BUTTONS_OK;
 }
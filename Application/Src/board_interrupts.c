@@ -42,6 +42,10 @@
 #include "at_modem_api.h"
 #include "console.h"
 
+#ifdef BSP_MOTION_FIFO_INT_PIN
+#include "sensor_drivers/motion_fifo.h"
+#endif
+
 /* NOTE : this code is designed for FreeRTOS */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -57,14 +61,12 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
         GPIO_PinState gstate =
                 HAL_GPIO_ReadPin(MODEM_RING_GPIO_PORT, MODEM_RING_PIN);
         atcc_hw_event(DEVTYPE_MODEM_CELLULAR, HWEVT_MODEM_RING, gstate);
-    } else if (GPIO_Pin == BSP_BUTTON) {
-        GPIO_PinState state = HAL_GPIO_ReadPin(BSP_BUTTON_PORT, BSP_BUTTON);
-        if (state) {
-            board_button_joy_sel_press();
-        } else {
-            board_button_joy_sel_release();
-        }
-
+    } else if (board_buttons_irq_handler(GPIO_Pin)) {
+        /* handled */
+#ifdef BSP_MOTION_FIFO_INT_PIN
+    } else if (GPIO_Pin == BSP_MOTION_FIFO_INT_PIN) {
+        motion_fifo_irq_handler();
+#endif
     } else {
         /* nothing to do */
     }
@@ -74,6 +76,10 @@ void HAL_GPIO_EXTI_Rising_Callback(uint16_t GPIO_Pin) {
     HAL_GPIO_EXTI_Callback(GPIO_Pin);
 }
 
+void HAL_GPIO_EXTI_Falling_Callback(uint16_t GPIO_Pin) {
+    HAL_GPIO_EXTI_Callback(GPIO_Pin);
+}
+
 void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart) {
     if (huart->Instance == MODEM_UART_INSTANCE) {
         IPC_UART_RxCpltCallback(huart);
@@ -0,0 +1,389 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <FreeRTOS.h>
+#include <cmsis_os.h>
+#include <task.h>
+
+#include <mbedtls/platform.h>
+
+#include <avsystem/commons/avs_defs.h>
+#include <avsystem/commons/avs_log.h>
+#include <avsystem/commons/avs_memory.h>
+
+#include "pool_allocator.h"
+
+#define LOG(level, ...) avs_log(pool_allocator, level, __VA_ARGS__)
+
+// Block sizes and counts of the pools, in increasing order of size. Sizes have
+// to be multiples of 8, so that all blocks are suitably aligned. The counts,
+// 4608 B in total, are estimates which have not been measured on the target
+// yet; the high-water marks and overflows logged periodically by the LwM2M
+// task are what they should be tuned with.
+#define POOL_ALLOCATOR_POOLS(X) \
+    X(16, 32)                   \
+    X(32, 32)                   \
+    X(64, 24)                   \
+    X(128, 12)
+
+// Threads with their own tag, see pool_allocator_tag_current_thread()
+#define POOL_ALLOCATOR_MAX_TAGGED_THREADS 4
+
+typedef union pool_block_union {
+    union pool_block_union *next;
+    uint64_t align;
+} pool_block_t;
+
+typedef struct {
+    uint8_t *storage;
+    // Tag of each block, valid while it is allocated
+    uint8_t *tags;
+    pool_block_t *free_list;
+    pool_allocator_pool_stats_t stats;
+} pool_t;
+
+// Precedes each allocation which is not served from a pool
+typedef union {
+    struct {
+        uint32_t size;
+        uint8_t tag;
+    } h;
+    uint64_t align;
+} heap_header_t;
+
+typedef struct {
+    osThreadId thread;
+    pool_allocator_tag_t tag;
+} thread_tag_t;
+
+#define POOL_STORAGE(Size, Count)                                  \
+    static uint64_t g_pool_##Size##_storage[(Size) * (Count) / 8]; \
+    static uint8_t g_pool_##Size##_tags[(Count)];
+POOL_ALLOCATOR_POOLS(POOL_STORAGE)
+#undef POOL_STORAGE
+
+#define POOL(Size, Count)                                  \
+    {                                                      \
+        .storage = (uint8_t *) g_pool_##Size##_storage,    \
+        .tags = g_pool_##Size##_tags,                      \
+        .stats = {                                         \
+            .block_size = (Size),                          \
+            .block_count = (Count)                         \
+        }                                                  \
+    },
+static pool_t g_pools[] = { POOL_ALLOCATOR_POOLS(POOL) };
+#undef POOL
+
+static bool g_pools_ready;
+static pool_allocator_tag_stats_t g_tag_stats[POOL_ALLOCATOR_TAGS_COUNT];
+static thread_tag_t g_thread_tags[POOL_ALLOCATOR_MAX_TAGGED_THREADS];
+
+static const char *const TAG_NAMES[POOL_ALLOCATOR_TAGS_COUNT] = {
+    [POOL_ALLOCATOR_TAG_APPLICATION] = "application",
+    [POOL_ALLOCATOR_TAG_LWM2M] = "lwm2m",
+    [POOL_ALLOCATOR_TAG_TLS] = "tls"
+};
+
+// Allocations may be made from any thread, but never from interrupt handlers,
+// so suspending the scheduler is enough. It also serializes the calls to
+// malloc(), whose locks are no-ops in this C library configuration.
+static void lock(void) {
+    vTaskSuspendAll();
+}
+
+static void unlock(void) {
+    (void) xTaskResumeAll();
+}
+
+// Called with the scheduler suspended
+static void ensure_pools_ready(void) {
+    if (g_pools_ready) {
+        return;
+    }
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(g_pools); i++) {
+        pool_t *pool = &g_pools[i];
+        pool->free_list = NULL;
+        for (size_t j = pool->stats.block_count; j-- > 0;) {
+            pool_block_t *block =
+                    (pool_block_t *) (pool->storage
+                                      + j * pool->stats.block_size);
+            block->next = pool->free_list;
+            pool->free_list = block;
+        }
+    }
+    g_pools_ready = true;
+}
+
+static pool_t *pool_for_size(size_t size) {
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(g_pools); i++) {
+        if (size <= g_pools[i].stats.block_size) {
+            return &g_pools[i];
+        }
+    }
+    return NULL;
+}
+
+static pool_t *pool_of(const void *ptr) {
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(g_pools); i++) {
+        const uint8_t *storage = g_pools[i].storage;
+        if ((const uint8_t *) ptr >= storage
+                && (const uint8_t *) ptr
+                           < storage
+                                     + (size_t) g_pools[i].stats.block_size
+                                               * g_pools[i].stats.block_count) {
+            return &g_pools[i];
+        }
+    }
+    return NULL;
+}
+
+static size_t block_index(const pool_t *pool, const void *ptr) {
+    return (size_t) ((const uint8_t *) ptr - pool->storage)
+           / pool->stats.block_size;
+}
+
+static heap_header_t *heap_header(void *ptr) {
+    return (heap_header_t *) ptr - 1;
+}
+
+static pool_allocator_tag_t current_thread_tag(void) {
+    osThreadId thread = osThreadGetId();
+    for (size_t i = 0; thread && i < AVS_ARRAY_SIZE(g_thread_tags); i++) {
+        if (g_thread_tags[i].thread == thread) {
+            return g_thread_tags[i].tag;
+        }
+    }
+    return POOL_ALLOCATOR_TAG_APPLICATION;
+}
+
+static void *alloc_tagged(size_t size, pool_allocator_tag_t tag) {
+    if (!size) {
+        return NULL;
+    }
+
+    void *result = NULL;
+    size_t held = 0;
+
+    lock();
+    ensure_pools_ready();
+    pool_t *pool = pool_for_size(size);
+    if (pool && pool->free_list) {
+        pool_block_t *block = pool->free_list;
+        pool->free_list = block->next;
+        pool->tags[block_index(pool, block)] = (uint8_t) tag;
+        if (++pool->stats.used > pool->stats.used_high_water) {
+            pool->stats.used_high_water = pool->stats.used;
+        }
+        result = block;
+        held = pool->stats.block_size;
+    } else {
+        if (pool) {
+            pool->stats.overflows++;
+        }
+        heap_header_t *header = NULL;
+        if (size <= UINT32_MAX - sizeof(heap_header_t)) {
+            header = (heap_header_t *) malloc(sizeof(heap_header_t) + size);
+        }
+        if (header) {
+            header->h.size = (uint32_t) size;
+            header->h.tag = (uint8_t) tag;
+            result = header + 1;
+            held = sizeof(heap_header_t) + size;
+        }
+    }
+
+    pool_allocator_tag_stats_t *stats = &g_tag_stats[tag];
+    if (result) {
+        stats->allocations++;
+        stats->bytes += held;
+        if (stats->bytes > stats->bytes_high_water) {
+            stats->bytes_high_water = stats->bytes;
+        }
+    } else {
+        stats->failures++;
+    }
+    unlock();
+    return result;
+}
+
+static void *
+calloc_tagged(size_t nmemb, size_t size, pool_allocator_tag_t tag) {
+    if (size && nmemb > SIZE_MAX / size) {
+        lock();
+        g_tag_stats[tag].failures++;
+        unlock();
+        return NULL;
+    }
+    void *result = alloc_tagged(nmemb * size, tag);
+    if (result) {
+        memset(result, 0, nmemb * size);
+    }
+    return result;
+}
+
+void *avs_malloc(size_t size) {
+    return alloc_tagged(size, current_thread_tag());
+}
+
+void *avs_calloc(size_t nmemb, size_t size) {
+    return calloc_tagged(nmemb, size, current_thread_tag());
+}
+
+void avs_free(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    lock();
+    pool_t *pool = pool_of(ptr);
+    pool_allocator_tag_t tag;
+    size_t held;
+    if (pool) {
+        tag = (pool_allocator_tag_t) pool->tags[block_index(pool, ptr)];
+        pool_block_t *block = (pool_block_t *) ptr;
+        block->next = pool->free_list;
+        pool->free_list = block;
+        pool->stats.used--;
+        held = pool->stats.block_size;
+    } else {
+        heap_header_t *header = heap_header(ptr);
+        tag = (pool_allocator_tag_t) header->h.tag;
+        held = sizeof(heap_header_t) + header->h.size;
+        free(header);
+    }
+    g_tag_stats[tag].allocations--;
+    g_tag_stats[tag].bytes -= held;
+    unlock();
+}
+
+void *avs_realloc(void *ptr, size_t size) {
+    if (!ptr) {
+        return avs_malloc(size);
+    }
+    if (!size) {
+        avs_free(ptr);
+        return NULL;
+    }
+
+    // Only the owner of ptr may modify its block or header, so these do not
+    // need the lock
+    pool_t *pool = pool_of(ptr);
+    size_t usable;
+    pool_allocator_tag_t tag;
+    if (pool) {
+        usable = pool->stats.block_size;
+        tag = (pool_allocator_tag_t) pool->tags[block_index(pool, ptr)];
+    } else {
+        usable = heap_header(ptr)->h.size;
+        tag = (pool_allocator_tag_t) heap_header(ptr)->h.tag;
+    }
+    if (size <= usable) {
+        return ptr;
+    }
+
+    void *result = alloc_tagged(size, tag);
+    if (result) {
+        memcpy(result, ptr, usable);
+        avs_free(ptr);
+    }
+    return result;
+}
+
+static void *tls_calloc(size_t nmemb, size_t size) {
+    return calloc_tagged(nmemb, size, POOL_ALLOCATOR_TAG_TLS);
+}
+
+void pool_allocator_init(void) {
+    if (mbedtls_platform_set_calloc_free(tls_calloc, avs_free)) {
+        LOG(WARNING, "could not set the mbedTLS allocator");
+    }
+}
+
+void pool_allocator_tag_current_thread(pool_allocator_tag_t tag) {
+    osThreadId thread = osThreadGetId();
+    bool tagged = false;
+
+    lock();
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(g_thread_tags); i++) {
+        if (!g_thread_tags[i].thread || g_thread_tags[i].thread == thread) {
+            g_thread_tags[i].thread = thread;
+            g_thread_tags[i].tag = tag;
+            tagged = true;
+            break;
+        }
+    }
+    unlock();
+
+    if (!tagged) {
+        LOG(WARNING, "too many tagged threads, allocations of %s accounted to "
+                     "%s",
+            TAG_NAMES[tag], TAG_NAMES[POOL_ALLOCATOR_TAG_APPLICATION]);
+    }
+}
+
+void pool_allocator_get_tag_stats(pool_allocator_tag_t tag,
+                                  pool_allocator_tag_stats_t *out_stats) {
+    lock();
+    *out_stats = g_tag_stats[tag];
+    unlock();
+}
+
+void pool_allocator_reset_high_water(pool_allocator_tag_t tag) {
+    lock();
+    g_tag_stats[tag].bytes_high_water = g_tag_stats[tag].bytes;
+    unlock();
+}
+
+size_t pool_allocator_pools_count(void) {
+    return AVS_ARRAY_SIZE(g_pools);
+}
+
+void pool_allocator_get_pool_stats(size_t index,
+                                   pool_allocator_pool_stats_t *out_stats) {
+    lock();
+    *out_stats = g_pools[index].stats;
+    unlock();
+}
+
+void pool_allocator_log_stats(void) {
+    for (int tag = 0; tag < POOL_ALLOCATOR_TAGS_COUNT; tag++) {
+        pool_allocator_tag_stats_t stats;
+        pool_allocator_get_tag_stats((pool_allocator_tag_t) tag, &stats);
+        LOG(INFO,
+            "memory used by %s: %lu B in %lu allocations, high-water %lu B, "
+            "%lu failed allocations",
+            TAG_NAMES[tag], (unsigned long) stats.bytes,
+            (unsigned long) stats.allocations,
+            (unsigned long) stats.bytes_high_water,
+            (unsigned long) stats.failures);
+    }
+    for (size_t i = 0; i < pool_allocator_pools_count(); i++) {
+        pool_allocator_pool_stats_t stats;
+        pool_allocator_get_pool_stats(i, &stats);
+        LOG(INFO,
+            "pool of %u B blocks: %u/%u used, high-water %u, %lu overflows to "
+            "heap",
+            (unsigned) stats.block_size, (unsigned) stats.used,
+            (unsigned) stats.block_count, (unsigned) stats.used_high_water,
+            (unsigned long) stats.overflows);
+    }
+}
@@ -21,6 +21,8 @@
 #include "avs_cmsis_os_structs.h"
 
 #include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
 
 // Code partially inspired by:
 // https://github.com/yaahallo/nachos/blob/master/threads/Condition.java
@@ -31,6 +33,12 @@
 // All rights reserved. Used under BSD license
 // (https://github.com/yaahallo/nachos/blob/master/README)
 
+// The notification value of a task is shared with osSignalSet() and
+// osSignalWait(), so a waiter only waits for and clears this bit. CMSIS-OS
+// signals use the lowest bits, and bit 31 would make the value returned by
+// osSignalWait() negative.
+#define CONDVAR_NOTIFICATION_BIT (UINT32_C(1) << 30)
+
 int avs_condvar_create(avs_condvar_t **out_condvar) {
     AVS_ASSERT(!*out_condvar,
                "possible attempt to reinitialize a condition variable");
@@ -52,7 +60,8 @@ int avs_condvar_notify_all(avs_condvar_t *condvar) {
     condvar_waiter_node_t *waiter = condvar->first_waiter;
     while (waiter) {
         // wake up the waiter
-        atomic_flag_clear(&waiter->waiting);
+        atomic_store(&waiter->notified, true);
+        (void) xTaskNotify(waiter->task, CONDVAR_NOTIFICATION_BIT, eSetBits);
 
         waiter = waiter->next;
     }
@@ -64,11 +73,8 @@ static void insert_new_waiter(avs_condvar_t *condvar,
                               condvar_waiter_node_t *waiter) {
     avs_mutex_lock(&condvar->waiters_mutex);
 
-    // Initialize the waiting flag to true
-    atomic_flag_clear(&waiter->waiting);
-    bool value = atomic_flag_test_and_set(&waiter->waiting);
-    assert(!value);
-    (void) value;
+    waiter->task = xTaskGetCurrentTaskHandle();
+    atomic_init(&waiter->notified, false);
 
     // Insert waiter as the first element on the list
     waiter->next = condvar->first_waiter;
@@ -77,7 +83,11 @@ static void insert_new_waiter(avs_condvar_t *condvar,
     avs_mutex_unlock(&condvar->waiters_mutex);
 }
 
-static void remove_waiter(avs_condvar_t *condvar,
+/**
+ * Returns whether the waiter has been notified before it was removed, even if
+ * it did not wake up on time because of that.
+ */
+static bool remove_waiter(avs_condvar_t *condvar,
                           condvar_waiter_node_t *waiter) {
     avs_mutex_lock(&condvar->waiters_mutex);
 
@@ -91,8 +101,36 @@ static void remove_waiter(avs_condvar_t *condvar,
         // detach it
         *waiter_node_ptr = (*waiter_node_ptr)->next;
     }
+    bool notified = atomic_load(&waiter->notified);
 
     avs_mutex_unlock(&condvar->waiters_mutex);
+    return notified;
+}
+
+/**
+ * Converts the time left until @p deadline to RTOS ticks, rounded up so that
+ * the task is never woken up before the deadline.
+ *
+ * @returns false if the deadline has already passed.
+ */
+static bool ticks_until(avs_time_monotonic_t deadline, TickType_t *out_ticks) {
+    avs_time_duration_t remaining =
+            avs_time_monotonic_diff(deadline, avs_time_monotonic_now());
+    if (!avs_time_duration_less(AVS_TIME_DURATION_ZERO, remaining)) {
+        return false;
+    }
+
+    static const int64_t TICK_US = 1000000 / configTICK_RATE_HZ;
+    // portMAX_DELAY itself would mean waiting forever
+    static const int64_t MAX_TICKS = (int64_t) portMAX_DELAY - 1;
+    int64_t remaining_us;
+    if (avs_time_duration_to_scalar(&remaining_us, AVS_TIME_US, remaining)
+            || remaining_us / TICK_US >= MAX_TICKS) {
+        *out_ticks = (TickType_t) MAX_TICKS;
+    } else {
+        *out_ticks = (TickType_t) ((remaining_us + TICK_US - 1) / TICK_US);
+    }
+    return true;
 }
 
 int avs_condvar_wait(avs_condvar_t *condvar,
@@ -102,24 +140,43 @@ int avs_condvar_wait(avs_condvar_t *condvar,
     // although we can't check if it's the current thread that locked it :(
 
     bool use_deadline = avs_time_monotonic_valid(deadline);
-    bool flag_value;
     condvar_waiter_node_t waiter;
     insert_new_waiter(condvar, &waiter);
 
     avs_mutex_unlock(mutex);
-    do {
-        flag_value = atomic_flag_test_and_set(&waiter.waiting);
-    } while (flag_value
-             && (!use_deadline
-                 || avs_time_monotonic_before(avs_time_monotonic_now(),
-                                              deadline)));
+    // Waiting consumes the pending state of the notification, so it has to be
+    // restored if signals for osSignalWait() arrived in the meantime
+    uint32_t other_bits = 0;
+    bool bit_consumed = false;
+    // The task may also be woken up by these signals, so only the notified
+    // flag is authoritative
+    while (!atomic_load(&waiter.notified)) {
+        TickType_t ticks = portMAX_DELAY;
+        if (use_deadline && !ticks_until(deadline, &ticks)) {
+            break;
+        }
+        uint32_t value = 0;
+        (void) xTaskNotifyWait(0, CONDVAR_NOTIFICATION_BIT, &value, ticks);
+        bit_consumed = bit_consumed || (value & CONDVAR_NOTIFICATION_BIT);
+        other_bits |= value & ~CONDVAR_NOTIFICATION_BIT;
+    }
     avs_mutex_lock(mutex);
 
-    remove_waiter(condvar, &waiter);
+    bool notified = remove_waiter(condvar, &waiter);
+    // Once removed, the waiter cannot be notified anymore. A notification that
+    // came after the last wait, e.g. right after the deadline, has left the bit
+    // pending, which would wake up the next osSignalWait() or avs_condvar_wait()
+    // of this task for nothing.
+    if (notified && !bit_consumed) {
+        uint32_t value = 0;
+        (void) xTaskNotifyWait(0, CONDVAR_NOTIFICATION_BIT, &value, 0);
+        other_bits |= value & ~CONDVAR_NOTIFICATION_BIT;
+    }
+    if (other_bits) {
+        (void) xTaskNotify(waiter.task, 0, eNoAction);
+    }
 
-    // flag_value == 0 -> it means it was cleared, so we've been woken up
-    // flag_value == 1 -> it mean we haven't, so timeout occurred
-    return flag_value ? AVS_CONDVAR_TIMEOUT : 0;
+    return notified ? 0 : AVS_CONDVAR_TIMEOUT;
 }
 
 void avs_condvar_cleanup(avs_condvar_t **condvar) {
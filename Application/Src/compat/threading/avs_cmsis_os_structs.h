@@ -22,7 +22,9 @@
 
 #include <stdatomic.h>
 
+#include "FreeRTOS.h"
 #include "cmsis_os.h"
+#include "task.h"
 
 struct avs_mutex {
     osStaticMutexDef_t control_block;
@@ -32,7 +34,9 @@ struct avs_mutex {
 
 // we are not using AVS_LIST because we want to use stack allocation
 typedef struct condvar_waiter_node_struct {
-    volatile atomic_flag waiting;
+    // Task blocked on its notification value until notified is set
+    TaskHandle_t task;
+    atomic_bool notified;
     struct condvar_waiter_node_struct *next;
 } condvar_waiter_node_t;
 
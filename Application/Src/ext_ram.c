@@ -0,0 +1,153 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <assert.h>
+#include <stdint.h>
+
+#include <avsystem/commons/avs_defs.h>
+#include <avsystem/commons/avs_log.h>
+#include <avsystem/commons/avs_mutex.h>
+
+#include "ext_ram.h"
+#include "ext_ram_driver.h"
+
+#define LOG(level, ...) avs_log(ext_ram, level, __VA_ARGS__)
+
+#define EXT_RAM_ALIGNMENT 8U
+// A free block is split only if the rest is worth a block of its own
+#define EXT_RAM_MIN_SPLIT_SIZE 64U
+
+/**
+ * Header preceding each block. Blocks tile the whole region, so the next one
+ * is found from the size of the current one. The external RAM serves a few
+ * large, long-lived buffers, so walking all the blocks is cheap enough, and
+ * there is no separate free list to keep consistent.
+ */
+typedef struct {
+    // Size of the block including this header, a multiple of the alignment
+    uint32_t size;
+    uint32_t used;
+} ext_ram_block_t;
+
+AVS_STATIC_ASSERT(sizeof(ext_ram_block_t) == EXT_RAM_ALIGNMENT,
+                  ext_ram_block_keeps_alignment);
+
+static avs_mutex_t *g_ext_ram_mutex;
+static uint8_t *g_ext_ram_base;
+static size_t g_ext_ram_size;
+
+static inline ext_ram_block_t *block_at(size_t offset) {
+    return (ext_ram_block_t *) (g_ext_ram_base + offset);
+}
+
+int ext_ram_init(void) {
+    void *base;
+    size_t size;
+    if (ext_ram_driver_init(&base, &size) || size == 0) {
+        return -1;
+    }
+
+    uintptr_t start = ((uintptr_t) base + EXT_RAM_ALIGNMENT - 1)
+                      & ~(uintptr_t) (EXT_RAM_ALIGNMENT - 1);
+    size -= (size_t) (start - (uintptr_t) base);
+    size = AVS_MIN(size, (size_t) UINT32_MAX)
+           & ~(size_t) (EXT_RAM_ALIGNMENT - 1);
+    if (size < 2 * sizeof(ext_ram_block_t)) {
+        return -1;
+    }
+    if (avs_mutex_create(&g_ext_ram_mutex)) {
+        LOG(ERROR, "couldn't create mutex");
+        return -1;
+    }
+
+    ext_ram_block_t *block = (ext_ram_block_t *) start;
+    block->size = (uint32_t) size;
+    block->used = 0;
+    g_ext_ram_size = size;
+    g_ext_ram_base = (uint8_t *) start;
+
+    LOG(INFO, "%lu kB of external RAM available",
+        (unsigned long) (size / 1024));
+    return 0;
+}
+
+void *ext_ram_alloc(size_t size) {
+    if (!g_ext_ram_base || size == 0
+            || size > g_ext_ram_size - sizeof(ext_ram_block_t)) {
+        return NULL;
+    }
+    uint32_t needed =
+            (uint32_t) (sizeof(ext_ram_block_t)
+                        + (size + EXT_RAM_ALIGNMENT - 1)
+                                  / EXT_RAM_ALIGNMENT * EXT_RAM_ALIGNMENT);
+    void *result = NULL;
+
+    avs_mutex_lock(g_ext_ram_mutex);
+    for (size_t offset = 0; offset < g_ext_ram_size;
+         offset += block_at(offset)->size) {
+        ext_ram_block_t *block = block_at(offset);
+        if (block->used || block->size < needed) {
+            continue;
+        }
+        if (block->size - needed >= EXT_RAM_MIN_SPLIT_SIZE) {
+            ext_ram_block_t *rest = block_at(offset + needed);
+            rest->size = block->size - needed;
+            rest->used = 0;
+            block->size = needed;
+        }
+        block->used = 1;
+        result = block + 1;
+        break;
+    }
+    avs_mutex_unlock(g_ext_ram_mutex);
+
+    if (!result) {
+        LOG(WARNING, "couldn't allocate %lu B of external RAM",
+            (unsigned long) size);
+    }
+    return result;
+}
+
+void ext_ram_free(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    ext_ram_block_t *freed = (ext_ram_block_t *) ptr - 1;
+    assert((uint8_t *) freed >= g_ext_ram_base
+           && (uint8_t *) freed < g_ext_ram_base + g_ext_ram_size);
+
+    avs_mutex_lock(g_ext_ram_mutex);
+    freed->used = 0;
+    // Merges every free block with the free blocks which follow it
+    for (size_t offset = 0; offset < g_ext_ram_size;
+         offset += block_at(offset)->size) {
+        ext_ram_block_t *block = block_at(offset);
+        if (block->used) {
+            continue;
+        }
+        while (offset + block->size < g_ext_ram_size
+               && !block_at(offset + block->size)->used) {
+            block->size += block_at(offset + block->size)->size;
+        }
+    }
+    avs_mutex_unlock(g_ext_ram_mutex);
+}
+
+bool ext_ram_contains(const void *ptr) {
+    return g_ext_ram_base && (const uint8_t *) ptr >= g_ext_ram_base
+           && (const uint8_t *) ptr < g_ext_ram_base + g_ext_ram_size;
+}
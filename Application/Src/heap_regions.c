@@ -0,0 +1,90 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <FreeRTOS.h>
+
+#include <avsystem/commons/avs_defs.h>
+#include <avsystem/commons/avs_log.h>
+
+#include "ext_ram.h"
+#include "heap_regions.h"
+#include "heap_regions_driver.h"
+
+#define LOG(level, ...) avs_log(heap_regions, level, __VA_ARGS__)
+
+#define HEAP_REGIONS_MAX_BANKS 4
+
+static uint8_t g_heap[configTOTAL_HEAP_SIZE];
+// Logged later, as heap_regions_init() runs before the log handler is set
+static size_t g_heap_size;
+static size_t g_regions_count;
+
+void heap_regions_init(void) {
+    heap_regions_bank_t banks[HEAP_REGIONS_MAX_BANKS];
+    size_t banks_count =
+            heap_regions_driver_get_banks(banks, AVS_ARRAY_SIZE(banks));
+
+    // One more for g_heap, and one for the terminator
+    HeapRegion_t regions[HEAP_REGIONS_MAX_BANKS + 2];
+    size_t regions_count = 0;
+    regions[regions_count++] = (HeapRegion_t) {
+        .pucStartAddress = g_heap,
+        .xSizeInBytes = sizeof(g_heap)
+    };
+    for (size_t i = 0; i < banks_count; i++) {
+        // heap_5 requires the regions in increasing address order
+        if (banks[i].base < g_heap + sizeof(g_heap)) {
+            LOG(ERROR, "SRAM bank at %p below the heap, skipped",
+                (void *) banks[i].base);
+            continue;
+        }
+        regions[regions_count++] = (HeapRegion_t) {
+            .pucStartAddress = banks[i].base,
+            .xSizeInBytes = banks[i].size
+        };
+    }
+    regions[regions_count] = (HeapRegion_t) {
+        .pucStartAddress = NULL,
+        .xSizeInBytes = 0
+    };
+    vPortDefineHeapRegions(regions);
+    g_heap_size = xPortGetFreeHeapSize();
+    g_regions_count = regions_count;
+}
+
+void heap_regions_log_stats(void) {
+    LOG(INFO, "%lu B of heap in %lu regions, %lu B free",
+        (unsigned long) g_heap_size, (unsigned long) g_regions_count,
+        (unsigned long) xPortGetFreeHeapSize());
+}
+
+void *heap_regions_alloc(size_t size, heap_regions_placement_t placement) {
+    if (placement == HEAP_REGIONS_COLD) {
+        return ext_ram_alloc(size);
+    }
+    return pvPortMalloc(size);
+}
+
+void heap_regions_free(void *ptr) {
+    if (ext_ram_contains(ptr)) {
+        ext_ram_free(ptr);
+    } else {
+        vPortFree(ptr);
+    }
+}
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -23,6 +24,10 @@
 #include <anjay/security.h>
 #include <anjay/server.h>
 
+#ifdef ANJAY_WITH_SEND
+#include <anjay/lwm2m_send.h>
+#endif // ANJAY_WITH_SEND
+
 #include <avsystem/commons/avs_log.h>
 #include <avsystem/commons/avs_prng.h>
 #include <avsystem/commons/avs_sched.h>
@@ -32,14 +37,25 @@
 #include <dc_common.h>
 #include <error_handler.h>
 
+#include <mbedtls/ssl.h>
+
 #include "application.h"
 #include "config_persistence.h"
+#include "conn_monitoring_object.h"
 #include "device_object.h"
 #include "lwm2m.h"
+#include "measurement_store.h"
 #include "menu.h"
 #include "persistence.h"
+#include "pool_allocator.h"
+#include "power_coordinator.h"
+#include "push_button_object.h"
 #include "sensor_objects.h"
+#include "task_stats_object.h"
+#include "tickless_idle.h"
+#include "timer_slots.h"
 
+#include "board_buttons.h"
 #include "joystick_object.h"
 
 #ifdef USE_SIM_BOOTSTRAP
@@ -76,39 +92,98 @@
 
 #define LOG(level, ...) avs_log(app, level, __VA_ARGS__)
 
+// SSID of the server configured through the console
+#define LWM2M_SERVER_SSID 1
+
+// Maximum fragment length requested in the DTLS handshake. Once the handshake
+// is over, mbedTLS (MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH) shrinks its record
+// buffers from MBEDTLS_SSL_IN_CONTENT_LEN and MBEDTLS_SSL_OUT_CONTENT_LEN to
+// that length, provided the server accepted the extension. The inner MTU of the
+// socket then leaves room for 512 B CoAP blocks only, so block-wise transfers,
+// e.g. FOTA downloads, use that size instead of 1024 B. The handshake itself
+// still runs with the full 4096 B buffers, so its peak is unchanged. Both are
+// reported as the TLS watermark and usage by pool_allocator_stats_job().
+#define LWM2M_TLS_MAX_FRAG_LEN MBEDTLS_SSL_MAX_FRAG_LEN_1024
+
+#if (USE_LOW_POWER == 1)
+// Queue mode lets the modem sleep between exchanges, see power_coordinator.h
+#define LWM2M_LIFETIME_S LWM2M_QUEUE_MODE_LIFETIME_S
+#define LWM2M_BINDING_QUEUE_MODE "Q"
+#else // (USE_LOW_POWER == 1)
+#define LWM2M_LIFETIME_S 60
+#define LWM2M_BINDING_QUEUE_MODE ""
+#endif // (USE_LOW_POWER == 1)
+
 anjay_t *volatile g_anjay;
 static avs_crypto_prng_ctx_t *g_prng_ctx;
 
 static osThreadId g_lwm2m_task_handle;
 static avs_sched_handle_t lwm2m_notify_job_handle;
+static avs_sched_handle_t sleep_residency_job_handle;
+static avs_sched_handle_t pool_allocator_stats_job_handle;
+static avs_sched_handle_t task_stats_job_handle;
 
 extern RNG_HandleTypeDef hrng;
 
 // Used to communicate between datacache callback and lwm2m thread
 static osMessageQId status_msg_queue;
 
+// Network state published by the datacache callback and handled by
+// update_network_state() in the LwM2M thread. g_network_up_count is incremented
+// each time the network goes up, at g_network_up_tick.
+static atomic_bool g_network_up;
+static atomic_uint_fast32_t g_network_up_count;
+static atomic_uint_fast32_t g_network_up_tick;
+// Value of g_network_up_count already handled by the LwM2M thread
+static uint_fast32_t g_handled_network_up_count;
+
 #ifdef USE_SMS_TRIGGER
 static anjay_smsdrv_t *sms_drv;
 static avs_sched_handle_t serve_sms_job_handle;
 #endif // USE_SMS_TRIGGER
 
+#ifdef ANJAY_WITH_SEND
+static anjay_send_batch_builder_t *g_send_batch_builder;
+static size_t g_send_batch_samples;
+static avs_sched_handle_t g_send_batch_flush_job_handle;
+// Totals since boot, to compare with reporting each value in its own Notify
+static uint32_t g_send_total_samples;
+static uint32_t g_send_total_messages;
+// Set if the last Send failed, until one succeeds; see send_store_mode()
+static bool g_send_failed;
+static avs_time_monotonic_t g_send_failed_time;
+// Position of the stored samples being sent, valid if g_send_store_in_flight
+static measurement_store_cursor_t g_send_store_cursor;
+static bool g_send_store_in_flight;
+#endif // ANJAY_WITH_SEND
+
+#ifdef ANJAY_WITH_SEND
+static void send_store_drain(anjay_t *anjay);
+#endif // ANJAY_WITH_SEND
+
 static void dc_cellular_callback(dc_com_event_id_t dc_event_id,
                                  const void *user_arg) {
     (void) user_arg;
 
+    conn_monitoring_object_dc_event(dc_event_id);
+
     if (dc_event_id == DC_CELLULAR_NIFMAN_INFO) {
         dc_nifman_info_t dc_nifman_info;
         (void) dc_com_read(&dc_com_db, DC_CELLULAR_NIFMAN_INFO,
                            (void *) &dc_nifman_info, sizeof(dc_nifman_info));
-        if (dc_nifman_info.rt_state == DC_SERVICE_ON) {
+        bool up = (dc_nifman_info.rt_state == DC_SERVICE_ON);
+        if (up == atomic_load(&g_network_up)) {
+            return;
+        }
+        if (up) {
             LOG(INFO, "network is up");
+            atomic_store(&g_network_up_tick, osKernelSysTick());
+            atomic_fetch_add(&g_network_up_count, 1);
+            atomic_store(&g_network_up, true);
             (void) osMessagePut(status_msg_queue, (uint32_t) dc_event_id, 0);
         } else {
-            anjay_t *anjay = g_anjay;
-            if (anjay) {
-                anjay_event_loop_interrupt(anjay);
-            }
             LOG(INFO, "network is down");
+            atomic_store(&g_network_up, false);
         }
     } else if (dc_event_id == DC_CELLULAR_CONFIG) {
         dc_cellular_params_t dc_cellular_params;
@@ -125,11 +200,96 @@ static void heartbeat_led_toggle(void) {
     HAL_GPIO_TogglePin(BSP_HEARTBEAT_LED_PORT, BSP_HEARTBEAT_LED);
 }
 
+/**
+ * Suspends the transports while the network is down, so that Anjay does not
+ * spend its retransmissions and backoff on a missing bearer, and reconnects as
+ * soon as it is up again, resuming the DTLS sessions kept by Anjay. The Update
+ * forced after reconnecting also tells the server the address the client may
+ * have got with the new bearer. The time from the network going up to the
+ * first successful Update is logged.
+ */
+static void update_network_state(anjay_t *anjay) {
+    static bool offline;
+    static bool measuring;
+    static uint32_t measure_start_tick;
+    static avs_time_real_t measure_expiration;
+
+    if (!atomic_load(&g_network_up)) {
+        if (!offline) {
+            LOG(INFO, "suspending LwM2M transports");
+            if (anjay_transport_enter_offline(anjay, ANJAY_TRANSPORT_SET_IP)) {
+                LOG(ERROR, "failed to enter offline mode");
+            } else {
+                offline = true;
+                measuring = false;
+            }
+        }
+        return;
+    }
+
+    uint_fast32_t up_count = atomic_load(&g_network_up_count);
+    if (up_count != g_handled_network_up_count) {
+        // The bearer changed, even if it went down and up between two runs of
+        // this job, so the sockets have to be reconnected anyway
+        g_handled_network_up_count = up_count;
+        int result = offline ? anjay_transport_exit_offline(
+                                       anjay, ANJAY_TRANSPORT_SET_IP)
+                             : anjay_transport_schedule_reconnect(
+                                       anjay, ANJAY_TRANSPORT_SET_IP);
+        if (result
+                || anjay_schedule_registration_update(anjay, ANJAY_SSID_ANY)) {
+            LOG(ERROR, "failed to reconnect LwM2M transports");
+            return;
+        }
+        LOG(INFO, "reconnecting LwM2M transports");
+        offline = false;
+        measuring = true;
+        measure_start_tick = (uint32_t) atomic_load(&g_network_up_tick);
+        measure_expiration =
+                anjay_registration_expiration_time(anjay, LWM2M_SERVER_SSID);
+    }
+
+    if (measuring) {
+        // The expiration time moves each time an Update succeeds; this is
+        // checked once per run of the job, so up to a second late
+        avs_time_real_t expiration =
+                anjay_registration_expiration_time(anjay, LWM2M_SERVER_SSID);
+        if (avs_time_real_valid(expiration)
+                && !avs_time_real_equal(expiration, measure_expiration)) {
+            measuring = false;
+            LOG(INFO, "first Update %lu ms after network up",
+                (unsigned long) (osKernelSysTick() - measure_start_tick));
+        }
+    }
+}
+
+/**
+ * Sensor objects are sampled only if observed, as often as their tightest
+ * active observation requires (see sensor_sampling.h); this job only gives them
+ * the opportunity to do so every second.
+ *
+ * Each sensor first reports the sample requested during the previous run and
+ * only then requests a new one, so all samples requested in one run are
+ * reported together in the next one, whenever the acquisition task publishes
+ * them. Anjay processes all changes notified within one scheduler job at once,
+ * so an Observe-Composite covering several sensors yields a single
+ * notification per cycle instead of one per changed resource.
+ */
 static void lwm2m_notify_job(avs_sched_t *sched, const void *anjay_ptr) {
-    static size_t cycle = 0;
     anjay_t *anjay = *(anjay_t *const *) anjay_ptr;
 
+    update_network_state(anjay);
+#ifdef ANJAY_WITH_SEND
+    send_store_drain(anjay);
+#endif // ANJAY_WITH_SEND
+
+    board_buttons_event_t button_event;
+    while (board_buttons_get_event(&button_event)) {
+        joystick_object_handle_event(anjay, &button_event);
+        push_button_object_handle_event(anjay, &button_event);
+    }
     joystick_object_update(anjay);
+    conn_monitoring_object_update(anjay);
 
 #ifdef USE_AIBP
     ml_model_object_update(anjay);
@@ -144,10 +304,7 @@ static void lwm2m_notify_job(avs_sched_t *sched, const void *anjay_ptr) {
 #endif
 
     three_axis_sensor_objects_update(anjay);
-
-    if (cycle % 5 == 0) {
-        basic_sensor_objects_update(anjay);
-    }
+    basic_sensor_objects_update(anjay);
 
     if (menu_is_module_persistence_enabled()
             && persistence_mod_persist_if_required(anjay)) {
@@ -156,15 +313,302 @@ static void lwm2m_notify_job(avs_sched_t *sched, const void *anjay_ptr) {
 
     heartbeat_led_toggle();
 
-    cycle++;
+#if (USE_LOW_POWER == 1)
+    // Not rescheduled yet, so this job is not seen as the next deadline
+    power_coordinator_update(anjay);
+#endif // (USE_LOW_POWER == 1)
+
     AVS_SCHED_DELAYED(sched, &lwm2m_notify_job_handle,
-                      avs_time_duration_from_scalar(1, AVS_TIME_S),
+                      avs_time_duration_from_scalar(
+                              timer_slots_periodic_delay_ms(1000),
+                              AVS_TIME_MS),
                       lwm2m_notify_job, &anjay, sizeof(anjay));
 }
 
+static void sleep_residency_job(avs_sched_t *sched, const void *arg) {
+    (void) arg;
+    static tickless_idle_stats_t last_stats;
+    static uint32_t last_tick;
+
+    tickless_idle_stats_t stats = tickless_idle_get_stats();
+    uint32_t tick = osKernelSysTick();
+    uint32_t period_ticks = tick - last_tick;
+    if (last_tick != 0 && period_ticks > 0) {
+        uint32_t sleep_ticks =
+                (uint32_t) (stats.sleep_ticks - last_stats.sleep_ticks);
+        LOG(INFO,
+            "MCU sleep residency: %lu.%lu%% in %lu sleeps over the last %lu s",
+            (unsigned long) (sleep_ticks * 100ULL / period_ticks),
+            (unsigned long) (sleep_ticks * 1000ULL / period_ticks % 10),
+            (unsigned long) (stats.sleeps - last_stats.sleeps),
+            (unsigned long) (period_ticks / 1000));
+    }
+    last_stats = stats;
+    last_tick = tick;
+
+    AVS_SCHED_DELAYED(sched, &sleep_residency_job_handle,
+                      avs_time_duration_from_scalar(
+                              timer_slots_periodic_delay_ms(
+                                      TICKLESS_IDLE_REPORT_PERIOD_S * 1000),
+                              AVS_TIME_MS),
+                      sleep_residency_job, NULL, 0);
+}
+
+static void pool_allocator_stats_job(avs_sched_t *sched, const void *arg) {
+    (void) arg;
+
+    pool_allocator_log_stats();
+
+    AVS_SCHED_DELAYED(sched, &pool_allocator_stats_job_handle,
+                      avs_time_duration_from_scalar(
+                              timer_slots_periodic_delay_ms(
+                                      POOL_ALLOCATOR_REPORT_PERIOD_S * 1000),
+                              AVS_TIME_MS),
+                      pool_allocator_stats_job, NULL, 0);
+}
+
+static void task_stats_job(avs_sched_t *sched, const void *anjay_ptr) {
+    anjay_t *anjay = *(anjay_t *const *) anjay_ptr;
+
+    task_stats_object_update(anjay);
+
+    AVS_SCHED_DELAYED(sched, &task_stats_job_handle,
+                      avs_time_duration_from_scalar(
+                              timer_slots_periodic_delay_ms(
+                                      TASK_STATS_SAMPLE_PERIOD_S * 1000),
+                              AVS_TIME_MS),
+                      task_stats_job, &anjay, sizeof(anjay));
+}
+
+#ifdef ANJAY_WITH_SEND
+static void send_finished_handler(anjay_t *anjay,
+                                  anjay_ssid_t ssid,
+                                  const anjay_send_batch_t *batch,
+                                  int result,
+                                  void *data) {
+    (void) anjay;
+    (void) ssid;
+    (void) batch;
+
+    if (data == &g_send_store_cursor) {
+        g_send_store_in_flight = false;
+        if (result == ANJAY_SEND_SUCCESS
+                && measurement_store_mark_sent(&g_send_store_cursor)) {
+            LOG(ERROR, "failed to mark stored samples as sent");
+        }
+    }
+
+    if (result != ANJAY_SEND_SUCCESS) {
+        LOG(WARNING, "LwM2M Send failed: %d", result);
+        g_send_failed = true;
+        g_send_failed_time = avs_time_monotonic_now();
+    } else {
+        g_send_failed = false;
+    }
+}
+
+/**
+ * Samples are kept in the measurement store instead of the Send batch while
+ * they are unlikely to get delivered, so that they survive a reset and do not
+ * pile up in RAM in the queue of deferred Send messages.
+ */
+static bool send_store_mode(anjay_t *anjay) {
+    return measurement_store_is_available()
+           && (!atomic_load(&g_network_up)
+               || anjay_all_connections_failed(anjay) || g_send_failed);
+}
+
+/**
+ * Sends the oldest stored samples, one batch at a time, with their original
+ * timestamps. The samples are marked as sent only once the server confirms
+ * them, so a failed batch is retried. After a failure, this is also what
+ * probes whether the server is reachable again.
+ */
+static void send_store_drain(anjay_t *anjay) {
+    static measurement_store_record_t records[LWM2M_SEND_BATCH_MAX_SAMPLES];
+
+    if (g_send_store_in_flight || !measurement_store_is_available()
+            || measurement_store_is_empty() || !atomic_load(&g_network_up)
+            || anjay_all_connections_failed(anjay)) {
+        return;
+    }
+    if (g_send_failed
+            && avs_time_monotonic_before(
+                       avs_time_monotonic_now(),
+                       avs_time_monotonic_add(
+                               g_send_failed_time,
+                               avs_time_duration_from_scalar(
+                                       LWM2M_SEND_STORE_RETRY_S,
+                                       AVS_TIME_S)))) {
+        return;
+    }
+
+    int count = measurement_store_peek(records, AVS_ARRAY_SIZE(records),
+                                       &g_send_store_cursor);
+    if (count <= 0) {
+        if (count < 0) {
+            LOG(ERROR, "failed to read stored samples");
+        }
+        return;
+    }
+
+    anjay_send_batch_builder_t *builder = anjay_send_batch_builder_new();
+    if (!builder) {
+        LOG(ERROR, "failed to create LwM2M Send batch");
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        if (anjay_send_batch_add_double(
+                    builder, records[i].oid, records[i].iid, records[i].rid,
+                    ANJAY_ID_INVALID,
+                    avs_time_real_from_scalar(records[i].timestamp_ms,
+                                              AVS_TIME_MS),
+                    records[i].value)) {
+            LOG(ERROR, "failed to add sample to LwM2M Send batch");
+            anjay_send_batch_builder_cleanup(&builder);
+            return;
+        }
+    }
+    anjay_send_batch_t *batch = anjay_send_batch_builder_compile(&builder);
+    if (!batch) {
+        LOG(ERROR, "failed to compile LwM2M Send batch");
+        anjay_send_batch_builder_cleanup(&builder);
+        return;
+    }
+
+    anjay_send_result_t result =
+            anjay_send_deferrable(anjay, LWM2M_SERVER_SSID, batch,
+                                  send_finished_handler, &g_send_store_cursor);
+    anjay_send_batch_release(&batch);
+    if (result != ANJAY_SEND_OK) {
+        LOG(WARNING, "failed to send %d stored samples: %d", count,
+            (int) result);
+        return;
+    }
+
+    g_send_store_in_flight = true;
+    g_send_total_samples += (uint32_t) count;
+    g_send_total_messages++;
+    LOG(INFO, "sending %d stored samples", count);
+}
+
+static void send_batch_flush(anjay_t *anjay) {
+    avs_sched_del(&g_send_batch_flush_job_handle);
+    if (!g_send_batch_builder) {
+        return;
+    }
+
+    size_t samples = g_send_batch_samples;
+    g_send_batch_samples = 0;
+    anjay_send_batch_t *batch =
+            anjay_send_batch_builder_compile(&g_send_batch_builder);
+    if (!batch) {
+        LOG(ERROR, "failed to compile LwM2M Send batch");
+        anjay_send_batch_builder_cleanup(&g_send_batch_builder);
+        return;
+    }
+
+    // If the server is offline, the message is sent once it is back online
+    anjay_send_result_t result =
+            anjay_send_deferrable(anjay, LWM2M_SERVER_SSID, batch,
+                                  send_finished_handler, NULL);
+    anjay_send_batch_release(&batch);
+    if (result != ANJAY_SEND_OK) {
+        LOG(WARNING, "failed to send %u samples: %d", (unsigned) samples,
+            (int) result);
+        return;
+    }
+
+    g_send_total_samples += samples;
+    g_send_total_messages++;
+    LOG(INFO, "sending %u samples, %lu samples in %lu messages since boot",
+        (unsigned) samples, (unsigned long) g_send_total_samples,
+        (unsigned long) g_send_total_messages);
+}
+
+static void send_batch_flush_job(avs_sched_t *sched, const void *anjay_ptr) {
+    (void) sched;
+    send_batch_flush(*(anjay_t *const *) anjay_ptr);
+}
+
+/**
+ * Returns the batch being built, creating it and scheduling its flush if
+ * needed, or NULL on error.
+ */
+static anjay_send_batch_builder_t *send_batch_builder(anjay_t *anjay) {
+    if (!g_send_batch_builder) {
+        if (!(g_send_batch_builder = anjay_send_batch_builder_new())) {
+            LOG(ERROR, "failed to create LwM2M Send batch");
+            return NULL;
+        }
+        AVS_SCHED_DELAYED(anjay_get_scheduler(anjay),
+                          &g_send_batch_flush_job_handle,
+                          avs_time_duration_from_scalar(
+                                  LWM2M_SEND_BATCH_MAX_DELAY_S, AVS_TIME_S),
+                          send_batch_flush_job, &anjay, sizeof(anjay));
+    }
+    return g_send_batch_builder;
+}
+
+static void send_batch_sample_added(anjay_t *anjay) {
+    if (++g_send_batch_samples >= LWM2M_SEND_BATCH_MAX_SAMPLES) {
+        send_batch_flush(anjay);
+    }
+}
+
+void lwm2m_send_batch_add_double(anjay_t *anjay,
+                                 anjay_oid_t oid,
+                                 anjay_iid_t iid,
+                                 anjay_rid_t rid,
+                                 double value) {
+    avs_time_real_t now = avs_time_real_now();
+    if (send_store_mode(anjay)) {
+        measurement_store_record_t record = {
+            .oid = oid,
+            .iid = iid,
+            .rid = rid,
+            .value = value
+        };
+        if (!avs_time_real_to_scalar(&record.timestamp_ms, AVS_TIME_MS, now)
+                && !measurement_store_append(&record)) {
+            return;
+        }
+        LOG(ERROR, "failed to store sample, adding it to LwM2M Send batch");
+    }
+
+    anjay_send_batch_builder_t *builder = send_batch_builder(anjay);
+    if (!builder
+            || anjay_send_batch_add_double(builder, oid, iid, rid,
+                                           ANJAY_ID_INVALID, now, value)) {
+        LOG(ERROR, "failed to add sample to LwM2M Send batch");
+        return;
+    }
+    send_batch_sample_added(anjay);
+}
+
+void lwm2m_send_batch_add_bool(anjay_t *anjay,
+                               anjay_oid_t oid,
+                               anjay_iid_t iid,
+                               anjay_rid_t rid,
+                               avs_time_monotonic_t time,
+                               bool value) {
+    avs_time_real_t timestamp = avs_time_real_add(
+            avs_time_real_now(),
+            avs_time_monotonic_diff(time, avs_time_monotonic_now()));
+    anjay_send_batch_builder_t *builder = send_batch_builder(anjay);
+    if (!builder
+            || anjay_send_batch_add_bool(builder, oid, iid, rid,
+                                         ANJAY_ID_INVALID, timestamp, value)) {
+        LOG(ERROR, "failed to add sample to LwM2M Send batch");
+        return;
+    }
+    send_batch_sample_added(anjay);
+}
+#endif // ANJAY_WITH_SEND
+
 static int setup_security_object_from_config(void) {
     anjay_security_instance_t security_instance = {
-        .ssid = 1,
+        .ssid = LWM2M_SERVER_SSID,
         .server_uri = g_config.server_uri,
 #ifdef USE_SMS_TRIGGER
         .sms_security_mode = ANJAY_SMS_SECURITY_NOSEC,
@@ -210,7 +654,8 @@ static const char *binding_mode_from_uri(const char *uri) {
     static const struct {
         const char *prefix;
         const char *mode;
-    } mode_dict[] = { { "coap+tcp://", "T" }, { "coaps+tcp://", "T" } };
+    } mode_dict[] = { { "coap+tcp://", "T" LWM2M_BINDING_QUEUE_MODE },
+                      { "coaps+tcp://", "T" LWM2M_BINDING_QUEUE_MODE } };
 
     for (size_t i = 0; i < AVS_ARRAY_SIZE(mode_dict); i++) {
         if (strncmp(mode_dict[i].prefix, uri, strlen(mode_dict[i].prefix))
@@ -219,7 +664,7 @@ static const char *binding_mode_from_uri(const char *uri) {
         }
     }
 
-    return "U";
+    return "U" LWM2M_BINDING_QUEUE_MODE;
 }
 
 static int setup_server_object_from_config(void) {
@@ -227,8 +672,8 @@ static int setup_server_object_from_config(void) {
         return 0;
     }
     const anjay_server_instance_t server_instance = {
-        .ssid = 1,
-        .lifetime = 60,
+        .ssid = LWM2M_SERVER_SSID,
+        .lifetime = LWM2M_LIFETIME_S,
         .default_min_period = -1,
         .default_max_period = -1,
         .disable_timeout = -1,
@@ -329,6 +774,21 @@ static int setup_required_objects(void) {
     return 0;
 }
 
+// Called by avs_net for each new (D)TLS socket, right before its handshake
+static int configure_tls(void *library_ssl_context) {
+    mbedtls_ssl_config *conf = (mbedtls_ssl_config *) library_ssl_context;
+
+    // The high-water mark of TLS allocations reported by
+    // pool_allocator_stats_job() is thus the peak of the last handshake, and
+    // the current usage is the steady state of the session
+    pool_allocator_reset_high_water(POOL_ALLOCATOR_TAG_TLS);
+
+    if (mbedtls_ssl_conf_max_frag_len(conf, LWM2M_TLS_MAX_FRAG_LEN)) {
+        LOG(WARNING, "could not set DTLS maximum fragment length");
+    }
+    return 0;
+}
+
 static anjay_t *create_and_setup_anjay(void) {
     anjay_configuration_t config = {
         .endpoint_name = g_config.endpoint_name,
@@ -337,6 +797,7 @@ static anjay_t *create_and_setup_anjay(void) {
         .msg_cache_size = 2048,
         .use_connection_id = true,
         .prng_ctx = g_prng_ctx,
+        .additional_tls_config_clb = configure_tls,
 #ifdef USE_SMS_TRIGGER
         .sms_driver = sms_drv,
         .local_msisdn =
@@ -345,7 +806,11 @@ static anjay_t *create_and_setup_anjay(void) {
     };
 
     anjay_t *anjay = NULL;
+#ifdef ANJAY_WITH_CORE_PERSISTENCE
+    anjay = persistence_core_restore(&config);
+#else  // ANJAY_WITH_CORE_PERSISTENCE
     anjay = anjay_new(&config);
+#endif // ANJAY_WITH_CORE_PERSISTENCE
     if (!anjay) {
         LOG(ERROR, "failed to create Anjay object");
         ERROR_Handler(DBG_CHAN_APPLICATION, 0, ERROR_FATAL);
@@ -357,7 +822,12 @@ static anjay_t *create_and_setup_anjay(void) {
     basic_sensor_objects_install(anjay);
     three_axis_sensor_objects_install(anjay);
 
-    joystick_object_install(anjay);
+    // The joystick object reports the board button if it is available
+    if (joystick_object_install(anjay)) {
+        push_button_object_install(anjay);
+    }
+    conn_monitoring_object_install(anjay);
+    task_stats_object_install(anjay);
 
 #ifdef USE_FW_UPDATE
     fw_update_install(anjay);
@@ -392,7 +862,9 @@ static void serve_sms_job(avs_sched_t *sched, const void *arg) {
             }
     }
     AVS_SCHED_DELAYED(sched, &serve_sms_job_handle,
-                      avs_time_duration_from_scalar(1, AVS_TIME_S),
+                      avs_time_duration_from_scalar(
+                              timer_slots_periodic_delay_ms(1000),
+                              AVS_TIME_MS),
                       serve_sms_job, NULL, 0);
 }
 #endif // USE_SMS_TRIGGER
@@ -400,7 +872,12 @@ static void serve_sms_job(avs_sched_t *sched, const void *arg) {
 static void lwm2m_thread(void const *user_arg) {
     (void) user_arg;
 
+    // Anjay, avs_coap and avs_net allocate in this thread only
+    pool_allocator_tag_current_thread(POOL_ALLOCATOR_TAG_LWM2M);
+
     (void) osMessageGet(status_msg_queue, osWaitForever);
+    // The first registration does not need a reconnection
+    g_handled_network_up_count = atomic_load(&g_network_up_count);
 
     int sync_time_result = avs_time_stm32_sync_time();
     if (sync_time_result) {
@@ -413,6 +890,11 @@ static void lwm2m_thread(void const *user_arg) {
     }
 #endif // USE_SMS_TRIGGER
 
+#ifdef ANJAY_WITH_SEND
+    // Without it, samples are only kept in RAM while they cannot be sent
+    (void) measurement_store_init();
+#endif // ANJAY_WITH_SEND
+
     anjay_t *anjay = create_and_setup_anjay();
 
     if (install_required_objects() || setup_required_objects()) {
@@ -420,8 +902,12 @@ static void lwm2m_thread(void const *user_arg) {
         ERROR_Handler(DBG_CHAN_APPLICATION, 0, ERROR_FATAL);
     }
 
+    // Also handles the network going down and up again from now on, see
+    // update_network_state()
     lwm2m_notify_job(anjay_get_scheduler(anjay), &anjay);
-    // TODO handle connection lost
+    sleep_residency_job(anjay_get_scheduler(anjay), NULL);
+    pool_allocator_stats_job(anjay_get_scheduler(anjay), NULL);
+    task_stats_job(anjay_get_scheduler(anjay), &anjay);
 
 #ifdef USE_SMS_TRIGGER
     if (menu_is_sms_trigger_enabled()) {
@@ -429,8 +915,16 @@ static void lwm2m_thread(void const *user_arg) {
     }
 #endif // USE_SMS_TRIGGER
 
+    // The notify job runs every second, aligned to the timer slots, so the
+    // maximum wait time never causes an extra wakeup
     anjay_event_loop_run(anjay, avs_time_duration_from_scalar(1, AVS_TIME_S));
 
+#ifdef ANJAY_WITH_SEND
+    anjay_send_batch_builder_cleanup(&g_send_batch_builder);
+    g_send_batch_samples = 0;
+    g_send_failed = false;
+#endif // ANJAY_WITH_SEND
+
 #ifdef USE_SMS_TRIGGER
     if (menu_is_sms_trigger_enabled()) {
         anjay_smsdrv_cleanup(&sms_drv);
@@ -438,6 +932,23 @@ static void lwm2m_thread(void const *user_arg) {
     }
 #endif // USE_SMS_TRIGGER
 
+#ifdef ANJAY_WITH_CORE_PERSISTENCE
+    // Lets the client resume its registration, observations and DTLS session
+    // after the reboot; attributes of the observations are in attr_storage.
+    // Only a Reboot requested through the Device object gets here: the event
+    // loop also ends on errors, after which the state is not worth resuming,
+    // and the firmware update reboot, watchdog and error resets bypass it.
+    if (device_object_is_reboot_requested()) {
+        if (menu_is_module_persistence_enabled()
+                && persistence_mod_persist_if_required(anjay)) {
+            LOG(ERROR, "Failed to persist modules");
+        }
+        g_anjay = NULL;
+        if (persistence_core_persist_and_delete(anjay)) {
+            LOG(WARNING, "client will register from scratch after reboot");
+        }
+    }
+#endif // ANJAY_WITH_CORE_PERSISTENCE
 
     device_object_reboot_if_requested();
 
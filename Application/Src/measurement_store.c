@@ -0,0 +1,332 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <measurement_store.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <avsystem/commons/avs_defs.h>
+#include <avsystem/commons/avs_log.h>
+
+#include <measurement_store_driver.h>
+
+#define LOG(level, ...) avs_log(measurement_store, level, __VA_ARGS__)
+
+// Last char denotes version
+#define MAGIC "anjay_meas\1"
+#define MAGIC_LEN (sizeof(MAGIC) - 1)
+
+// Values of the state byte, each one programmable over the previous one
+#define STATE_ERASED 0xFF
+#define STATE_VALID 0x7F
+#define STATE_SENT 0x00
+
+typedef struct {
+    char magic[MAGIC_LEN];
+    uint32_t seq;
+} sector_header_t;
+
+typedef struct {
+    // Programmed last when appending, see measurement_store.h
+    uint8_t state;
+    uint8_t reserved;
+    uint16_t oid;
+    uint16_t iid;
+    uint16_t rid;
+    int64_t timestamp_ms;
+    double value;
+} raw_record_t;
+
+#define SLOT_SIZE sizeof(raw_record_t)
+#define SLOTS_PER_SECTOR (MEASUREMENT_STORE_SECTOR_SIZE / SLOT_SIZE)
+// Slot 0 of each sector holds the sector header
+#define FIRST_RECORD_SLOT 1
+
+AVS_STATIC_ASSERT(SLOT_SIZE == 24, raw_record_packed);
+AVS_STATIC_ASSERT(sizeof(sector_header_t) <= SLOT_SIZE, header_fits_slot);
+
+static size_t g_sector_count;
+// Newest sector and its first free slot, SLOTS_PER_SECTOR if it is full
+static size_t g_head_sector;
+static size_t g_head_slot;
+static uint32_t g_head_seq;
+// Oldest record that may not be sent yet; equal to the head if there is none
+static size_t g_tail_sector;
+static size_t g_tail_slot;
+// Incremented each time records are dropped, to invalidate cursors
+static uint32_t g_generation;
+
+static bool is_head(size_t sector, size_t slot) {
+    return sector == g_head_sector && slot == g_head_slot;
+}
+
+static void advance(size_t *sector, size_t *slot) {
+    assert(!is_head(*sector, *slot));
+    // A full head sector is only left when a record is appended
+    if (++*slot >= SLOTS_PER_SECTOR && *sector != g_head_sector) {
+        *sector = (*sector + 1) % g_sector_count;
+        *slot = FIRST_RECORD_SLOT;
+    }
+}
+
+static int read_slot(size_t sector, size_t slot, raw_record_t *out_raw) {
+    return measurement_store_driver_read(sector, slot * SLOT_SIZE, out_raw,
+                                         SLOT_SIZE);
+}
+
+static int read_state(size_t sector, size_t slot, uint8_t *out_state) {
+    return measurement_store_driver_read(sector, slot * SLOT_SIZE, out_state,
+                                         1);
+}
+
+static int write_state(size_t sector, size_t slot, uint8_t state) {
+    return measurement_store_driver_write(sector, slot * SLOT_SIZE, &state, 1);
+}
+
+static bool is_erased(const void *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (((const uint8_t *) data)[i] != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool read_header(size_t sector, uint32_t *out_seq) {
+    sector_header_t header;
+    if (measurement_store_driver_read(sector, 0, &header, sizeof(header))
+            || memcmp(header.magic, MAGIC, MAGIC_LEN)) {
+        return false;
+    }
+    *out_seq = header.seq;
+    return true;
+}
+
+static int open_next_sector(void) {
+    size_t next = (g_head_sector + 1) % g_sector_count;
+    bool was_empty = measurement_store_is_empty();
+    if (!was_empty && g_tail_sector == next) {
+        LOG(WARNING, "store full, dropping oldest measurements");
+        g_tail_sector = (next + 1) % g_sector_count;
+        g_tail_slot = FIRST_RECORD_SLOT;
+        g_generation++;
+    }
+
+    sector_header_t header;
+    memset(&header, 0, sizeof(header));
+    // Zeroing the old magic first makes a sector whose erase gets interrupted
+    // unrecognizable on the next boot
+    if (measurement_store_driver_write(next, 0, &header, sizeof(header))
+            || measurement_store_driver_erase(next)) {
+        LOG(ERROR, "failed to erase sector %u", (unsigned) next);
+        return -1;
+    }
+    memcpy(header.magic, MAGIC, MAGIC_LEN);
+    header.seq = g_head_seq + 1;
+    if (measurement_store_driver_write(next, 0, &header, sizeof(header))) {
+        LOG(ERROR, "failed to write header of sector %u", (unsigned) next);
+        return -1;
+    }
+
+    g_head_sector = next;
+    g_head_slot = FIRST_RECORD_SLOT;
+    g_head_seq = header.seq;
+    if (was_empty) {
+        g_tail_sector = g_head_sector;
+        g_tail_slot = g_head_slot;
+    }
+    return 0;
+}
+
+static int find_head_slot(void) {
+    for (g_head_slot = FIRST_RECORD_SLOT; g_head_slot < SLOTS_PER_SECTOR;
+         g_head_slot++) {
+        raw_record_t raw;
+        if (read_slot(g_head_sector, g_head_slot, &raw)) {
+            return -1;
+        }
+        // Records torn by a reset are neither erased nor valid, and are
+        // skipped like the sent ones
+        if (is_erased(&raw, sizeof(raw))) {
+            break;
+        }
+    }
+    return 0;
+}
+
+static int find_tail(void) {
+    // Sectors are reused in order, so the oldest one follows the newest one
+    g_tail_sector = g_head_sector;
+    for (size_t i = 1; i < g_sector_count; i++) {
+        size_t sector = (g_head_sector + i) % g_sector_count;
+        uint32_t seq;
+        if (read_header(sector, &seq) && g_head_seq - seq < g_sector_count) {
+            g_tail_sector = sector;
+            break;
+        }
+    }
+    g_tail_slot = FIRST_RECORD_SLOT;
+
+    while (!is_head(g_tail_sector, g_tail_slot)) {
+        uint8_t state;
+        if (read_state(g_tail_sector, g_tail_slot, &state)) {
+            return -1;
+        }
+        if (state == STATE_VALID) {
+            break;
+        }
+        advance(&g_tail_sector, &g_tail_slot);
+    }
+    return 0;
+}
+
+int measurement_store_init(void) {
+    g_sector_count = measurement_store_driver_sector_count();
+    if (g_sector_count < 2) {
+        g_sector_count = 0;
+        LOG(INFO, "no flash for the measurement store on this board");
+        return -1;
+    }
+
+    bool found = false;
+    for (size_t sector = 0; sector < g_sector_count; sector++) {
+        uint32_t seq;
+        if (read_header(sector, &seq)
+                && (!found || (int32_t) (seq - g_head_seq) > 0)) {
+            found = true;
+            g_head_sector = sector;
+            g_head_seq = seq;
+        }
+    }
+
+    if (!found) {
+        // The first append opens sector 0
+        g_head_sector = g_sector_count - 1;
+        g_head_slot = SLOTS_PER_SECTOR;
+        g_head_seq = 0;
+        g_tail_sector = g_head_sector;
+        g_tail_slot = g_head_slot;
+    } else if (find_head_slot() || find_tail()) {
+        LOG(ERROR, "failed to read the measurement store");
+        g_sector_count = 0;
+        return -1;
+    }
+
+    LOG(INFO, "%u sectors of %u records, %s", (unsigned) g_sector_count,
+        (unsigned) (SLOTS_PER_SECTOR - FIRST_RECORD_SLOT),
+        measurement_store_is_empty() ? "empty" : "measurements pending");
+    return 0;
+}
+
+bool measurement_store_is_available(void) {
+    return g_sector_count > 0;
+}
+
+bool measurement_store_is_empty(void) {
+    return is_head(g_tail_sector, g_tail_slot);
+}
+
+int measurement_store_append(const measurement_store_record_t *record) {
+    if (!measurement_store_is_available()
+            || (g_head_slot >= SLOTS_PER_SECTOR && open_next_sector())) {
+        return -1;
+    }
+
+    raw_record_t raw = {
+        .state = STATE_ERASED,
+        .reserved = 0xFF,
+        .oid = record->oid,
+        .iid = record->iid,
+        .rid = record->rid,
+        .timestamp_ms = record->timestamp_ms,
+        .value = record->value
+    };
+    size_t slot = g_head_slot++;
+    // Even if it fails, the slot may be partially programmed and is skipped
+    if (measurement_store_driver_write(g_head_sector, slot * SLOT_SIZE, &raw,
+                                       sizeof(raw))
+            || write_state(g_head_sector, slot, STATE_VALID)) {
+        return -1;
+    }
+    return 0;
+}
+
+int measurement_store_peek(measurement_store_record_t *out_records,
+                           size_t max_records,
+                           measurement_store_cursor_t *out_cursor) {
+    size_t sector = g_tail_sector;
+    size_t slot = g_tail_slot;
+    size_t count = 0;
+    while (count < max_records && !is_head(sector, slot)) {
+        raw_record_t raw;
+        if (read_slot(sector, slot, &raw)) {
+            return -1;
+        }
+        if (raw.state == STATE_VALID) {
+            out_records[count++] = (measurement_store_record_t) {
+                .oid = raw.oid,
+                .iid = raw.iid,
+                .rid = raw.rid,
+                .timestamp_ms = raw.timestamp_ms,
+                .value = raw.value
+            };
+        }
+        advance(&sector, &slot);
+        if (!count) {
+            // Skipped records will not be needed anymore
+            g_tail_sector = sector;
+            g_tail_slot = slot;
+        }
+    }
+
+    out_cursor->sector = sector;
+    out_cursor->slot = slot;
+    out_cursor->generation = g_generation;
+    return (int) count;
+}
+
+int measurement_store_mark_sent(const measurement_store_cursor_t *cursor) {
+    if (cursor->generation != g_generation) {
+        LOG(WARNING, "measurements dropped while being sent");
+        return 0;
+    }
+
+    size_t end_sector = cursor->sector;
+    size_t end_slot = cursor->slot;
+    if (end_slot >= SLOTS_PER_SECTOR) {
+        // The sector was the head one when peeked, but another one may have
+        // been opened since then
+        end_sector = (end_sector + 1) % g_sector_count;
+        end_slot = FIRST_RECORD_SLOT;
+    }
+
+    while (!is_head(g_tail_sector, g_tail_slot)
+           && (g_tail_sector != end_sector || g_tail_slot != end_slot)) {
+        uint8_t state;
+        if (read_state(g_tail_sector, g_tail_slot, &state)
+                || (state == STATE_VALID
+                    && write_state(g_tail_sector, g_tail_slot, STATE_SENT))) {
+            return -1;
+        }
+        advance(&g_tail_sector, &g_tail_slot);
+    }
+    return 0;
+}
@@ -230,6 +230,10 @@ static void enter_menu(void) {
                     if (config_save(&g_config)) {
                         LOG(WARNING, "Could not save config");
                     }
+#ifdef ANJAY_WITH_CORE_PERSISTENCE
+                    // Registration state refers to the previous settings
+                    persistence_core_clear();
+#endif // ANJAY_WITH_CORE_PERSISTENCE
                 }
                 console_printf("\r\nExiting menu...\r\n");
                 break;
@@ -18,43 +18,87 @@
 #include <anjay/ipso_objects.h>
 #include <avsystem/commons/avs_defs.h>
 
+#include "lwm2m.h"
 #include "sensor_drivers/basic_sensor_driver.h"
+#include "sensor_acquisition.h"
 #include "sensor_drivers/bsp_sensor_drivers.h"
+#include "sensor_sampling.h"
+
+// Sampling period of an observed sensor without pmin
+#define BASIC_SENSOR_DEFAULT_PERIOD_S 5
+
+#define BASIC_SENSOR_VALUE_RID 5700
+
+// Sensor Value, Min Measured Value, Max Measured Value
+static const anjay_rid_t BASIC_SENSOR_SAMPLED_RIDS[] = {
+    BASIC_SENSOR_VALUE_RID, 5601, 5602
+};
 
 typedef struct {
     anjay_oid_t oid;
     const basic_sensor_driver_t *driver;
     const char *unit;
     bool installed;
+    sensor_sampling_t sampling;
+    sensor_acquisition_source_t acquisition;
+    uint32_t last_acquisition_seq;
 } sensor_context_t;
 
 static sensor_context_t basic_sensors_def[] = {
     {
         .oid = 3303,
         .driver = &BSP_THERMOMETER_DRIVER,
-        .unit = "Cel"
+        .unit = "Cel",
+        .sampling = SENSOR_SAMPLING_INITIALIZER(
+                BASIC_SENSOR_DEFAULT_PERIOD_S,
+                SENSOR_SAMPLING_BACKGROUND_PERIOD_S)
     },
     {
         .oid = 3304,
         .driver = &BSP_HYGROMETER_DRIVER,
-        .unit = "%RH"
+        .unit = "%RH",
+        .sampling = SENSOR_SAMPLING_INITIALIZER(
+                BASIC_SENSOR_DEFAULT_PERIOD_S,
+                SENSOR_SAMPLING_BACKGROUND_PERIOD_S)
     },
     {
         .oid = 3315,
         .driver = &BSP_BAROMETER_DRIVER,
-        .unit = "Pa"
+        .unit = "Pa",
+        .sampling = SENSOR_SAMPLING_INITIALIZER(
+                BASIC_SENSOR_DEFAULT_PERIOD_S,
+                SENSOR_SAMPLING_BACKGROUND_PERIOD_S)
     }
 };
 
+// Called from the sensor acquisition task
+static int acquire_value(const void *_ctx,
+                         sensor_acquisition_sample_t *out_sample) {
+    const basic_sensor_driver_t *driver =
+            ((const sensor_context_t *) _ctx)->driver;
+
+    return driver->read(&out_sample->values[0]);
+}
+
+// Called from the sensor acquisition task
+static int set_power(const void *_ctx,
+                     sensor_power_state_t state,
+                     float odr_hz) {
+    const basic_sensor_driver_t *driver =
+            ((const sensor_context_t *) _ctx)->driver;
+
+    return driver->set_power_state(state, odr_hz);
+}
+
 static int read_value(anjay_iid_t iid, void *_ctx, double *out_value) {
-    const basic_sensor_driver_t *driver = ((sensor_context_t *) _ctx)->driver;
+    sensor_context_t *ctx = (sensor_context_t *) _ctx;
 
-    float fvalue;
-    if (driver->read(&fvalue)) {
+    sensor_acquisition_sample_t sample;
+    if (sensor_acquisition_get(&ctx->acquisition, &sample)) {
         return -1;
     }
 
-    *out_value = (double) fvalue;
+    *out_value = (double) sample.values[0];
 
     return 0;
 }
@@ -64,6 +108,10 @@ void basic_sensor_objects_install(anjay_t *anjay) {
         sensor_context_t *ctx = &basic_sensors_def[i];
 
         if (ctx->driver->init()
+                || sensor_acquisition_register(
+                           &ctx->acquisition, acquire_value,
+                           ctx->driver->set_power_state ? set_power : NULL,
+                           ctx)
                 || anjay_ipso_basic_sensor_install(anjay, ctx->oid, 1)) {
             continue;
         }
@@ -84,8 +132,34 @@ void basic_sensor_objects_update(anjay_t *anjay) {
     for (int i = 0; i < AVS_ARRAY_SIZE(basic_sensors_def); i++) {
         sensor_context_t *ctx = &basic_sensors_def[i];
 
-        if (ctx->installed) {
+        if (!ctx->installed) {
+            continue;
+        }
+
+        if (sensor_acquisition_has_new_sample(&ctx->acquisition,
+                                              &ctx->last_acquisition_seq)) {
             anjay_ipso_basic_sensor_update(anjay, ctx->oid, 0);
+#ifdef ANJAY_WITH_SEND
+            sensor_acquisition_sample_t sample;
+            if (!sensor_acquisition_get(&ctx->acquisition, &sample)) {
+                lwm2m_send_batch_add_double(anjay, ctx->oid, 0,
+                                            BASIC_SENSOR_VALUE_RID,
+                                            (double) sample.values[0]);
+            }
+#endif // ANJAY_WITH_SEND
+        }
+
+        // The new sample will be reported during the next call
+        if (sensor_sampling_is_due(anjay, &ctx->sampling, ctx->oid, 0,
+                                   BASIC_SENSOR_SAMPLED_RIDS,
+                                   AVS_ARRAY_SIZE(BASIC_SENSOR_SAMPLED_RIDS))) {
+            sensor_acquisition_request(&ctx->acquisition);
         }
+
+        // Applied before the requested sample is acquired, if any
+        float odr_hz;
+        sensor_power_state_t state =
+                sensor_sampling_power_state(&ctx->sampling, &odr_hz);
+        sensor_acquisition_set_power(&ctx->acquisition, state, odr_hz);
     }
 }
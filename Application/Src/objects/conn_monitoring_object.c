@@ -0,0 +1,317 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * LwM2M Object: Connectivity Monitoring
+ * ID: 4, URN: urn:oma:lwm2m:oma:4, Optional, Single
+ *
+ * This LwM2M Object enables monitoring of parameters related to network
+ * connectivity.
+ *
+ * All values come from the cellular data cache, which the cellular service
+ * keeps up to date, so reading them costs no AT commands. Changes are notified
+ * when the data cache reports an update of the corresponding entry.
+ */
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <anjay/anjay.h>
+#include <avsystem/commons/avs_defs.h>
+#include <avsystem/commons/avs_log.h>
+
+#include <cellular_service_datacache.h>
+#include <com_sockets.h>
+#include <dc_common.h>
+
+#include "conn_monitoring_object.h"
+
+#define CONN_MONITORING_OBJ_LOG(...) avs_log(conn_monitoring_obj, __VA_ARGS__)
+
+/**
+ * Network Bearer: R, Single, Mandatory
+ * type: integer, range: N/A, unit: N/A
+ * Indicates the network bearer used for the current LwM2M communication
+ * session.
+ */
+#define RID_NETWORK_BEARER 0
+
+/**
+ * Available Network Bearer: R, Multiple, Mandatory
+ * type: integer, range: N/A, unit: N/A
+ * Indicates list of current available network bearer. Each Resource
+ * Instance has a value from the network bearer list.
+ */
+#define RID_AVAILABLE_NETWORK_BEARER 1
+
+/**
+ * Radio Signal Strength: R, Single, Mandatory
+ * type: integer, range: N/A, unit: dBm
+ * This node contains the average value of the received signal strength
+ * indication used in the current network bearer.
+ */
+#define RID_RADIO_SIGNAL_STRENGTH 2
+
+/**
+ * IP Addresses: R, Multiple, Mandatory
+ * type: string, range: N/A, unit: N/A
+ * The IP addresses assigned to the connectivity interface.
+ */
+#define RID_IP_ADDRESSES 4
+
+#define CONN_MONITORING_OID 4
+
+// Network Bearer values defined by the object
+#define NETWORK_BEARER_GSM 0
+#define NETWORK_BEARER_LTE_FDD 6
+#define NETWORK_BEARER_NB_IOT 7
+
+// Access technologies the cellular service can report
+static const int32_t AVAILABLE_NETWORK_BEARERS[] = {
+    NETWORK_BEARER_GSM, NETWORK_BEARER_LTE_FDD, NETWORK_BEARER_NB_IOT
+};
+
+typedef struct conn_monitoring_object_struct {
+    const anjay_dm_object_def_t *def;
+
+    // Set by the data cache callback
+    atomic_bool signal_info_changed;
+    atomic_bool nifman_info_changed;
+
+    // Last values seen by the LwM2M thread
+    int32_t network_bearer;
+    int32_t radio_signal_strength;
+    uint32_t ip_addr;
+} conn_monitoring_object_t;
+
+static inline conn_monitoring_object_t *
+get_obj(const anjay_dm_object_def_t *const *obj_ptr) {
+    assert(obj_ptr);
+    return AVS_CONTAINER_OF(obj_ptr, conn_monitoring_object_t, def);
+}
+
+static int32_t network_bearer(ca_access_techno_t access_techno) {
+    switch (access_techno) {
+    case CA_ACT_GSM:
+        return NETWORK_BEARER_GSM;
+    case CA_ACT_E_UTRAN_NBS1:
+        return NETWORK_BEARER_NB_IOT;
+    case CA_ACT_E_UTRAN:
+    default:
+        // LTE Cat.M1 has no dedicated value
+        return NETWORK_BEARER_LTE_FDD;
+    }
+}
+
+static int read_signal_info(int32_t *out_network_bearer,
+                            int32_t *out_radio_signal_strength) {
+    dc_signal_info_t signal_info;
+    if (dc_com_read(&dc_com_db, DC_CELLULAR_SIGNAL_INFO, (void *) &signal_info,
+                    sizeof(signal_info))
+                    != DC_COM_OK
+            || signal_info.rt_state != DC_SERVICE_ON) {
+        return -1;
+    }
+    *out_network_bearer = network_bearer(signal_info.access_techno);
+    *out_radio_signal_strength = signal_info.cs_signal_level_db;
+    return 0;
+}
+
+static int read_ip_addr(uint32_t *out_ip_addr) {
+    dc_nifman_info_t nifman_info;
+    if (dc_com_read(&dc_com_db, DC_CELLULAR_NIFMAN_INFO, (void *) &nifman_info,
+                    sizeof(nifman_info))
+                    != DC_COM_OK
+            || nifman_info.rt_state != DC_SERVICE_ON) {
+        return -1;
+    }
+    *out_ip_addr = nifman_info.ip_addr.addr;
+    return 0;
+}
+
+static int list_resources(anjay_t *anjay,
+                          const anjay_dm_object_def_t *const *obj_ptr,
+                          anjay_iid_t iid,
+                          anjay_dm_resource_list_ctx_t *ctx) {
+    (void) anjay;
+    (void) obj_ptr;
+    (void) iid;
+
+    anjay_dm_emit_res(ctx, RID_NETWORK_BEARER, ANJAY_DM_RES_R,
+                      ANJAY_DM_RES_PRESENT);
+    anjay_dm_emit_res(ctx, RID_AVAILABLE_NETWORK_BEARER, ANJAY_DM_RES_RM,
+                      ANJAY_DM_RES_PRESENT);
+    anjay_dm_emit_res(ctx, RID_RADIO_SIGNAL_STRENGTH, ANJAY_DM_RES_R,
+                      ANJAY_DM_RES_PRESENT);
+    anjay_dm_emit_res(ctx, RID_IP_ADDRESSES, ANJAY_DM_RES_RM,
+                      ANJAY_DM_RES_PRESENT);
+    return 0;
+}
+
+static int list_resource_instances(anjay_t *anjay,
+                                   const anjay_dm_object_def_t *const *obj_ptr,
+                                   anjay_iid_t iid,
+                                   anjay_rid_t rid,
+                                   anjay_dm_list_ctx_t *ctx) {
+    (void) anjay;
+    (void) obj_ptr;
+    (void) iid;
+
+    switch (rid) {
+    case RID_AVAILABLE_NETWORK_BEARER:
+        for (anjay_riid_t riid = 0;
+             riid < AVS_ARRAY_SIZE(AVAILABLE_NETWORK_BEARERS);
+             riid++) {
+            anjay_dm_emit(ctx, riid);
+        }
+        return 0;
+
+    case RID_IP_ADDRESSES: {
+        uint32_t ip_addr;
+        if (!read_ip_addr(&ip_addr)) {
+            anjay_dm_emit(ctx, 0);
+        }
+        return 0;
+    }
+
+    default:
+        return ANJAY_ERR_METHOD_NOT_ALLOWED;
+    }
+}
+
+static int resource_read(anjay_t *anjay,
+                         const anjay_dm_object_def_t *const *obj_ptr,
+                         anjay_iid_t iid,
+                         anjay_rid_t rid,
+                         anjay_riid_t riid,
+                         anjay_output_ctx_t *ctx) {
+    (void) anjay;
+    (void) obj_ptr;
+    assert(iid == 0);
+    (void) iid;
+
+    switch (rid) {
+    case RID_NETWORK_BEARER:
+    case RID_RADIO_SIGNAL_STRENGTH: {
+        assert(riid == ANJAY_ID_INVALID);
+        int32_t bearer;
+        int32_t strength;
+        if (read_signal_info(&bearer, &strength)) {
+            return ANJAY_ERR_SERVICE_UNAVAILABLE;
+        }
+        return anjay_ret_i32(ctx,
+                             rid == RID_NETWORK_BEARER ? bearer : strength);
+    }
+
+    case RID_AVAILABLE_NETWORK_BEARER:
+        assert(riid < AVS_ARRAY_SIZE(AVAILABLE_NETWORK_BEARERS));
+        return anjay_ret_i32(ctx, AVAILABLE_NETWORK_BEARERS[riid]);
+
+    case RID_IP_ADDRESSES: {
+        assert(riid == 0);
+        uint32_t ip_addr;
+        if (read_ip_addr(&ip_addr)) {
+            return ANJAY_ERR_NOT_FOUND;
+        }
+        com_ip_addr_t com_ip_addr = {
+            .addr = ip_addr
+        };
+        char ip_str[sizeof("255.255.255.255")];
+        // PRIu8 is unsupported in reduced newlib, see
+        // xcc_com_sockets_net_impl.c
+        snprintf(ip_str, sizeof(ip_str), "%u.%u.%u.%u",
+                 (unsigned int) COM_IP4_ADDR1(&com_ip_addr),
+                 (unsigned int) COM_IP4_ADDR2(&com_ip_addr),
+                 (unsigned int) COM_IP4_ADDR3(&com_ip_addr),
+                 (unsigned int) COM_IP4_ADDR4(&com_ip_addr));
+        return anjay_ret_string(ctx, ip_str);
+    }
+
+    default:
+        return ANJAY_ERR_METHOD_NOT_ALLOWED;
+    }
+}
+
+static const anjay_dm_object_def_t OBJ_DEF = {
+    .oid = CONN_MONITORING_OID,
+    .handlers = {
+        .list_instances = anjay_dm_list_instances_SINGLE,
+
+        .list_resources = list_resources,
+        .list_resource_instances = list_resource_instances,
+        .resource_read = resource_read,
+    }
+};
+
+static conn_monitoring_object_t CONN_MONITORING_OBJECT = {
+    .def = &OBJ_DEF
+};
+
+static const anjay_dm_object_def_t **OBJ_DEF_PTR = &CONN_MONITORING_OBJECT.def;
+
+int conn_monitoring_object_install(anjay_t *anjay) {
+    conn_monitoring_object_t *obj = get_obj(OBJ_DEF_PTR);
+    // Compare against the current values from now on
+    atomic_store(&obj->signal_info_changed, true);
+    atomic_store(&obj->nifman_info_changed, true);
+    return anjay_register_object(anjay, OBJ_DEF_PTR);
+}
+
+void conn_monitoring_object_dc_event(dc_com_event_id_t dc_event_id) {
+    conn_monitoring_object_t *obj = get_obj(OBJ_DEF_PTR);
+
+    if (dc_event_id == DC_CELLULAR_SIGNAL_INFO) {
+        atomic_store(&obj->signal_info_changed, true);
+    } else if (dc_event_id == DC_CELLULAR_NIFMAN_INFO) {
+        atomic_store(&obj->nifman_info_changed, true);
+    }
+}
+
+void conn_monitoring_object_update(anjay_t *anjay) {
+    conn_monitoring_object_t *obj = get_obj(OBJ_DEF_PTR);
+
+    int32_t bearer;
+    int32_t strength;
+    if (atomic_exchange(&obj->signal_info_changed, false)
+            && !read_signal_info(&bearer, &strength)) {
+        if (obj->network_bearer != bearer) {
+            obj->network_bearer = bearer;
+            anjay_notify_changed(anjay, CONN_MONITORING_OID, 0,
+                                 RID_NETWORK_BEARER);
+        }
+        if (obj->radio_signal_strength != strength) {
+            obj->radio_signal_strength = strength;
+            anjay_notify_changed(anjay, CONN_MONITORING_OID, 0,
+                                 RID_RADIO_SIGNAL_STRENGTH);
+        }
+    }
+
+    if (atomic_exchange(&obj->nifman_info_changed, false)) {
+        uint32_t ip_addr;
+        if (read_ip_addr(&ip_addr)) {
+            ip_addr = 0;
+        }
+        if (obj->ip_addr != ip_addr) {
+            obj->ip_addr = ip_addr;
+            anjay_notify_changed(anjay, CONN_MONITORING_OID, 0,
+                                 RID_IP_ADDRESSES);
+        }
+    }
+}
@@ -299,6 +299,10 @@ int device_object_install(anjay_t *anjay) {
     return anjay_register_object(anjay, OBJ_DEF_PTR);
 }
 
+bool device_object_is_reboot_requested(void) {
+    return reboot;
+}
+
 void device_object_reboot_if_requested(void) {
     if (reboot) {
         avs_log(device, INFO, "Rebooting...");
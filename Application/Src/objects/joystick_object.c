@@ -25,7 +25,6 @@
  * an associated push button.
  */
 #include <assert.h>
-#include <stdatomic.h>
 #include <stdbool.h>
 
 #include <anjay/anjay.h>
@@ -34,7 +33,10 @@
 #include <avsystem/commons/avs_log.h>
 #include <avsystem/commons/avs_memory.h>
 
+#include "board_buttons.h"
+#include "lwm2m.h"
 #include "main.h"
+#include "sensor_sampling.h"
 
 #if defined(BSP_JOYSTICK_PRESENT) && !defined(ANJAY_WITH_CORE_PERSISTENCE)
 
@@ -70,14 +72,19 @@
 
 #define JOYSTICK_OID 3345
 
+// Sampling period of an observed joystick without pmin
+#define JOYSTICK_DEFAULT_PERIOD_S 1
+
+// The other inputs are reported as they change, see
+// joystick_object_handle_event()
+static const anjay_rid_t JOYSTICK_SAMPLED_RIDS[] = { RID_X_VALUE };
+
 typedef struct multiple_axis_joystick_object_struct {
     const anjay_dm_object_def_t *def;
 
-    bool sel;
-    atomic_uint_fast32_t sel_counter;
-    uint32_t last_sel_counter;
+    uint32_t sel_counter;
     int8_t x_value;
-    int8_t y_value;
+    sensor_sampling_t sampling;
 } multiple_axis_joystick_object_t;
 
 static inline multiple_axis_joystick_object_t *
@@ -104,7 +111,7 @@ static int instance_reset(anjay_t *anjay,
     (void) iid;
 
     multiple_axis_joystick_object_t *obj = get_obj(obj_ptr);
-    atomic_store(&obj->sel_counter, 0);
+    obj->sel_counter = 0;
     return 0;
 }
 
@@ -125,28 +132,30 @@ static int list_resources(anjay_t *anjay,
     return 0;
 }
 
+// RIGHT shares its EXTI line with the motion sensor FIFO, so unlike the other
+// directions it is polled rather than reported by board_buttons
 static int8_t read_x_value() {
     if (HAL_GPIO_ReadPin(RIGHT_JOY_GPIO_PORT, RIGHT_JOY_PIN)) {
         return 1;
     }
-    if (HAL_GPIO_ReadPin(LEFT_JOY_GPIO_PORT, LEFT_JOY_PIN)) {
+    if (board_buttons_is_pressed(BOARD_BUTTONS_JOY_LEFT)) {
         return -1;
     }
     return 0;
 }
 
 static int8_t read_y_value() {
-    if (HAL_GPIO_ReadPin(UP_JOY_GPIO_PORT, UP_JOY_PIN)) {
+    if (board_buttons_is_pressed(BOARD_BUTTONS_JOY_UP)) {
         return 1;
     }
-    if (HAL_GPIO_ReadPin(DOWN_JOY_GPIO_PORT, DOWN_JOY_PIN)) {
+    if (board_buttons_is_pressed(BOARD_BUTTONS_JOY_DOWN)) {
         return -1;
     }
     return 0;
 }
 
 static bool read_sel() {
-    return HAL_GPIO_ReadPin(SEL_JOY_GPIO_PORT, SEL_JOY_PIN);
+    return board_buttons_is_pressed(BOARD_BUTTONS_BUTTON);
 }
 
 static int resource_read(anjay_t *anjay,
@@ -169,7 +178,7 @@ static int resource_read(anjay_t *anjay,
 
     case RID_DIGITAL_INPUT_COUNTER:
         assert(riid == ANJAY_ID_INVALID);
-        return anjay_ret_i32(ctx, atomic_load(&obj->sel_counter));
+        return anjay_ret_i64(ctx, obj->sel_counter);
 
     case RID_X_VALUE:
         assert(riid == ANJAY_ID_INVALID);
@@ -196,7 +205,8 @@ static const anjay_dm_object_def_t OBJ_DEF = {
 };
 
 static multiple_axis_joystick_object_t JOY_OBJECT = {
-    .def = &OBJ_DEF
+    .def = &OBJ_DEF,
+    .sampling = SENSOR_SAMPLING_INITIALIZER(JOYSTICK_DEFAULT_PERIOD_S, 0)
 };
 
 static const anjay_dm_object_def_t **OBJ_DEF_PTR = &JOY_OBJECT.def;
@@ -205,44 +215,67 @@ int joystick_object_install(anjay_t *anjay) {
     return anjay_register_object(anjay, OBJ_DEF_PTR);
 }
 
-void joystick_object_increment_counter(void) {
-    multiple_axis_joystick_object_t *obj = get_obj(OBJ_DEF_PTR);
-    atomic_fetch_add(&obj->sel_counter, 1);
-}
-
 void joystick_object_update(anjay_t *anjay) {
     multiple_axis_joystick_object_t *obj = get_obj(OBJ_DEF_PTR);
 
-    int8_t x_value = read_x_value();
-    int8_t y_value = read_y_value();
-    bool sel = read_sel();
+    if (!sensor_sampling_is_due(anjay, &obj->sampling, JOYSTICK_OID, 0,
+                                JOYSTICK_SAMPLED_RIDS,
+                                AVS_ARRAY_SIZE(JOYSTICK_SAMPLED_RIDS))) {
+        return;
+    }
 
+    int8_t x_value = read_x_value();
     if (obj->x_value != x_value) {
         obj->x_value = x_value;
         anjay_notify_changed(anjay, JOYSTICK_OID, 0, RID_X_VALUE);
     }
+}
 
-    if (obj->y_value != y_value) {
-        obj->y_value = y_value;
-        anjay_notify_changed(anjay, JOYSTICK_OID, 0, RID_Y_VALUE);
-    }
+void joystick_object_handle_event(anjay_t *anjay,
+                                  const board_buttons_event_t *event) {
+    multiple_axis_joystick_object_t *obj = get_obj(OBJ_DEF_PTR);
 
-    if (obj->sel != sel) {
-        obj->sel = sel;
+    switch (event->input) {
+    case BOARD_BUTTONS_BUTTON:
+        if (event->pressed) {
+            obj->sel_counter++;
+            anjay_notify_changed(anjay, JOYSTICK_OID, 0,
+                                 RID_DIGITAL_INPUT_COUNTER);
+        }
         anjay_notify_changed(anjay, JOYSTICK_OID, 0, RID_DIGITAL_INPUT_STATE);
+#ifdef ANJAY_WITH_SEND
+        // The state may have changed back by the time a notification is sent,
+        // so every edge is also reported with the time it happened at
+        lwm2m_send_batch_add_bool(anjay, JOYSTICK_OID, 0,
+                                  RID_DIGITAL_INPUT_STATE, event->time,
+                                  event->pressed);
+#endif // ANJAY_WITH_SEND
+        break;
+
+    case BOARD_BUTTONS_JOY_LEFT: {
+        int8_t x_value = read_x_value();
+        if (obj->x_value != x_value) {
+            obj->x_value = x_value;
+            anjay_notify_changed(anjay, JOYSTICK_OID, 0, RID_X_VALUE);
+        }
+        break;
     }
 
-    uint32_t sel_counter_val = atomic_load(&obj->sel_counter);
-    if (obj->last_sel_counter != sel_counter_val) {
-        obj->last_sel_counter = sel_counter_val;
-        anjay_notify_changed(anjay, JOYSTICK_OID, 0, RID_DIGITAL_INPUT_COUNTER);
+    case BOARD_BUTTONS_JOY_UP:
+    case BOARD_BUTTONS_JOY_DOWN:
+        anjay_notify_changed(anjay, JOYSTICK_OID, 0, RID_Y_VALUE);
+        break;
+
+    default:
+        break;
     }
 }
 
 #else // defined(BSP_JOYSTICK_PRESENT) && !defined(ANJAY_WITH_CORE_PERSISTENCE)
 
-void joystick_object_increment_counter(void) {}
 void joystick_object_update(anjay_t *anjay) {}
+void joystick_object_handle_event(anjay_t *anjay,
+                                  const board_buttons_event_t *event) {}
 int joystick_object_install(anjay_t *anjay) {
     return -1;
 }
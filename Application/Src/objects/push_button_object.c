@@ -0,0 +1,57 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdbool.h>
+
+#include <anjay/anjay.h>
+#include <anjay/ipso_objects.h>
+
+#include "board_buttons.h"
+#include "lwm2m.h"
+#include "push_button_object.h"
+
+#define PUSH_BUTTON_OID 3347
+#define PUSH_BUTTON_DIGITAL_INPUT_STATE_RID 5500
+
+static bool g_push_button_installed;
+
+int push_button_object_install(anjay_t *anjay) {
+    if (anjay_ipso_button_install(anjay, 1)
+            || anjay_ipso_button_instance_add(anjay, 0, "User button")) {
+        return -1;
+    }
+    g_push_button_installed = true;
+    // Edges which happened before are not counted
+    return anjay_ipso_button_update(
+            anjay, 0, board_buttons_is_pressed(BOARD_BUTTONS_BUTTON));
+}
+
+void push_button_object_handle_event(anjay_t *anjay,
+                                     const board_buttons_event_t *event) {
+    if (!g_push_button_installed || event->input != BOARD_BUTTONS_BUTTON) {
+        return;
+    }
+    // Each edge updates the state, which increments the counter on presses
+    (void) anjay_ipso_button_update(anjay, 0, event->pressed);
+#ifdef ANJAY_WITH_SEND
+    // The button may be released by the time a notification is sent, so every
+    // edge is also reported with the time it happened at
+    lwm2m_send_batch_add_bool(anjay, PUSH_BUTTON_OID, 0,
+                              PUSH_BUTTON_DIGITAL_INPUT_STATE_RID, event->time,
+                              event->pressed);
+#endif // ANJAY_WITH_SEND
+}
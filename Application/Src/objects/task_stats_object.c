@@ -0,0 +1,312 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * LwM2M Object: Task Statistics
+ * ID: 32101 (private range), Optional, Multiple
+ *
+ * Reports the CPU usage and the stack usage of each FreeRTOS task, one
+ * instance per task. Instances are assigned to tasks in the order in which
+ * they are first seen, and removed when their task is deleted.
+ *
+ * The kernel accounts the run time of each task on every context switch with
+ * the counter described in run_time_counter.h. The statistics are only
+ * collected every TASK_STATS_SAMPLE_PERIOD_S, with a single
+ * uxTaskGetSystemState() call, which also scans the unused part of each stack
+ * to find its high water mark.
+ */
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <anjay/anjay.h>
+#include <avsystem/commons/avs_defs.h>
+#include <avsystem/commons/avs_log.h>
+#include <avsystem/commons/avs_memory.h>
+
+#include "task_stats_object.h"
+
+#define TASK_STATS_OBJ_LOG(...) avs_log(task_stats_obj, __VA_ARGS__)
+
+/**
+ * Task Name: R, Single, Mandatory
+ * type: string, range: N/A, unit: N/A
+ * Name the task was created with.
+ */
+#define RID_TASK_NAME 0
+
+/**
+ * CPU Usage: R, Single, Mandatory
+ * type: float, range: 0..100, unit: %
+ * Share of the time the task was running during the last sample period. Time
+ * spent in Sleep mode is accounted to the idle task.
+ */
+#define RID_CPU_USAGE 1
+
+/**
+ * Minimum Free Stack: R, Single, Mandatory
+ * type: integer, range: N/A, unit: B
+ * Least amount of stack that has remained unused since the task was created.
+ */
+#define RID_MINIMUM_FREE_STACK 2
+
+#define TASK_STATS_OID 32101
+
+#define TASK_STATS_MAX_TASKS 16
+// Room for tasks created while the statistics are being collected
+#define TASK_STATS_SPARE_STATUSES 2
+// CPU usage is kept in hundredths of a percent
+#define TASK_STATS_CPU_USAGE_SCALE 10000U
+
+typedef struct {
+    bool present;
+    UBaseType_t task_number;
+    char name[configMAX_TASK_NAME_LEN];
+    // Run time counter of the task at the previous sample
+    uint32_t last_run_time;
+    uint16_t cpu_usage;
+    uint32_t minimum_free_stack;
+} task_stats_instance_t;
+
+typedef struct task_stats_object_struct {
+    const anjay_dm_object_def_t *def;
+
+    bool installed;
+    // Total run time at the previous sample
+    uint32_t last_total_run_time;
+    task_stats_instance_t instances[TASK_STATS_MAX_TASKS];
+} task_stats_object_t;
+
+static inline task_stats_object_t *
+get_obj(const anjay_dm_object_def_t *const *obj_ptr) {
+    assert(obj_ptr);
+    return AVS_CONTAINER_OF(obj_ptr, task_stats_object_t, def);
+}
+
+static int list_instances(anjay_t *anjay,
+                          const anjay_dm_object_def_t *const *obj_ptr,
+                          anjay_dm_list_ctx_t *ctx) {
+    (void) anjay;
+
+    task_stats_object_t *obj = get_obj(obj_ptr);
+    for (anjay_iid_t iid = 0; iid < AVS_ARRAY_SIZE(obj->instances); iid++) {
+        if (obj->instances[iid].present) {
+            anjay_dm_emit(ctx, iid);
+        }
+    }
+    return 0;
+}
+
+static int list_resources(anjay_t *anjay,
+                          const anjay_dm_object_def_t *const *obj_ptr,
+                          anjay_iid_t iid,
+                          anjay_dm_resource_list_ctx_t *ctx) {
+    (void) anjay;
+    (void) obj_ptr;
+    (void) iid;
+
+    anjay_dm_emit_res(ctx, RID_TASK_NAME, ANJAY_DM_RES_R,
+                      ANJAY_DM_RES_PRESENT);
+    anjay_dm_emit_res(ctx, RID_CPU_USAGE, ANJAY_DM_RES_R,
+                      ANJAY_DM_RES_PRESENT);
+    anjay_dm_emit_res(ctx, RID_MINIMUM_FREE_STACK, ANJAY_DM_RES_R,
+                      ANJAY_DM_RES_PRESENT);
+    return 0;
+}
+
+static int resource_read(anjay_t *anjay,
+                         const anjay_dm_object_def_t *const *obj_ptr,
+                         anjay_iid_t iid,
+                         anjay_rid_t rid,
+                         anjay_riid_t riid,
+                         anjay_output_ctx_t *ctx) {
+    (void) anjay;
+    (void) riid;
+
+    task_stats_object_t *obj = get_obj(obj_ptr);
+    assert(iid < AVS_ARRAY_SIZE(obj->instances));
+    const task_stats_instance_t *inst = &obj->instances[iid];
+    assert(inst->present);
+
+    switch (rid) {
+    case RID_TASK_NAME:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_string(ctx, inst->name);
+
+    case RID_CPU_USAGE:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_float(ctx, (float) inst->cpu_usage
+                                            / (TASK_STATS_CPU_USAGE_SCALE
+                                               / 100U));
+
+    case RID_MINIMUM_FREE_STACK:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_i32(ctx, (int32_t) inst->minimum_free_stack);
+
+    default:
+        return ANJAY_ERR_METHOD_NOT_ALLOWED;
+    }
+}
+
+static const anjay_dm_object_def_t OBJ_DEF = {
+    .oid = TASK_STATS_OID,
+    .handlers = {
+        .list_instances = list_instances,
+
+        .list_resources = list_resources,
+        .resource_read = resource_read,
+    }
+};
+
+static task_stats_object_t TASK_STATS_OBJECT = {
+    .def = &OBJ_DEF
+};
+
+static const anjay_dm_object_def_t **OBJ_DEF_PTR = &TASK_STATS_OBJECT.def;
+
+static bool task_exists(const TaskStatus_t *statuses,
+                        UBaseType_t count,
+                        UBaseType_t task_number) {
+    for (UBaseType_t i = 0; i < count; i++) {
+        if (statuses[i].xTaskNumber == task_number) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static task_stats_instance_t *find_instance(task_stats_object_t *obj,
+                                            UBaseType_t task_number,
+                                            bool *out_created) {
+    task_stats_instance_t *free_inst = NULL;
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(obj->instances); i++) {
+        task_stats_instance_t *inst = &obj->instances[i];
+        if (!inst->present) {
+            if (!free_inst) {
+                free_inst = inst;
+            }
+        } else if (inst->task_number == task_number) {
+            *out_created = false;
+            return inst;
+        }
+    }
+    if (free_inst) {
+        free_inst->present = true;
+        free_inst->task_number = task_number;
+        // The whole run time of the task is new since the previous sample
+        free_inst->last_run_time = 0;
+        *out_created = true;
+    }
+    return free_inst;
+}
+
+static void update_instance(anjay_t *anjay,
+                            anjay_iid_t iid,
+                            task_stats_instance_t *inst,
+                            const TaskStatus_t *status,
+                            uint32_t period,
+                            bool created) {
+    if (created) {
+        snprintf(inst->name, sizeof(inst->name), "%s", status->pcTaskName);
+    }
+
+    uint16_t cpu_usage = 0;
+    if (period > 0) {
+        uint64_t run_time = status->ulRunTimeCounter - inst->last_run_time;
+        // The run time of the task may be accounted a bit later than the total
+        cpu_usage = (uint16_t) AVS_MIN(run_time * TASK_STATS_CPU_USAGE_SCALE
+                                               / period,
+                                       TASK_STATS_CPU_USAGE_SCALE);
+    }
+    inst->last_run_time = status->ulRunTimeCounter;
+    uint32_t minimum_free_stack =
+            (uint32_t) status->usStackHighWaterMark * sizeof(StackType_t);
+
+    if (!created && inst->cpu_usage != cpu_usage) {
+        anjay_notify_changed(anjay, TASK_STATS_OID, iid, RID_CPU_USAGE);
+    }
+    inst->cpu_usage = cpu_usage;
+    if (!created && inst->minimum_free_stack != minimum_free_stack) {
+        anjay_notify_changed(anjay, TASK_STATS_OID, iid,
+                             RID_MINIMUM_FREE_STACK);
+    }
+    inst->minimum_free_stack = minimum_free_stack;
+}
+
+int task_stats_object_install(anjay_t *anjay) {
+    int result = anjay_register_object(anjay, OBJ_DEF_PTR);
+    // Instances are created by the first task_stats_object_update()
+    get_obj(OBJ_DEF_PTR)->installed = !result;
+    return result;
+}
+
+void task_stats_object_update(anjay_t *anjay) {
+    task_stats_object_t *obj = get_obj(OBJ_DEF_PTR);
+    if (!obj->installed) {
+        return;
+    }
+
+    UBaseType_t capacity = uxTaskGetNumberOfTasks() + TASK_STATS_SPARE_STATUSES;
+    TaskStatus_t *statuses =
+            (TaskStatus_t *) avs_malloc(capacity * sizeof(*statuses));
+    if (!statuses) {
+        TASK_STATS_OBJ_LOG(WARNING, "out of memory");
+        return;
+    }
+    uint32_t total_run_time;
+    UBaseType_t count =
+            uxTaskGetSystemState(statuses, capacity, &total_run_time);
+    if (!count) {
+        // More tasks were created meanwhile than there was room for
+        avs_free(statuses);
+        return;
+    }
+    uint32_t period = total_run_time - obj->last_total_run_time;
+    obj->last_total_run_time = total_run_time;
+
+    bool instances_changed = false;
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(obj->instances); i++) {
+        task_stats_instance_t *inst = &obj->instances[i];
+        if (inst->present
+                && !task_exists(statuses, count, inst->task_number)) {
+            inst->present = false;
+            instances_changed = true;
+        }
+    }
+
+    for (UBaseType_t i = 0; i < count; i++) {
+        bool created;
+        task_stats_instance_t *inst =
+                find_instance(obj, statuses[i].xTaskNumber, &created);
+        if (!inst) {
+            TASK_STATS_OBJ_LOG(WARNING, "no instance left for task %s",
+                               statuses[i].pcTaskName);
+            continue;
+        }
+        instances_changed = instances_changed || created;
+        update_instance(anjay, (anjay_iid_t) (inst - obj->instances), inst,
+                        &statuses[i], period, created);
+    }
+    avs_free(statuses);
+
+    if (instances_changed) {
+        anjay_notify_instances_changed(anjay, TASK_STATS_OID);
+    }
+}
@@ -18,50 +18,104 @@
 #include <anjay/ipso_objects.h>
 #include <avsystem/commons/avs_defs.h>
 
+#include "lwm2m.h"
+#include "sensor_acquisition.h"
 #include "sensor_drivers/bsp_sensor_drivers.h"
 #include "sensor_drivers/three_axis_sensor_driver.h"
+#include "sensor_sampling.h"
+
+// Sampling period of an observed sensor without pmin
+#define THREE_AXIS_SENSOR_DEFAULT_PERIOD_S 1
+
+// X Value, Y Value, Z Value
+static const anjay_rid_t THREE_AXIS_SENSOR_SAMPLED_RIDS[] = { 5702, 5703,
+                                                              5704 };
 
 typedef struct {
     anjay_oid_t oid;
     const three_axis_sensor_driver_t *driver;
     const char *unit;
     bool installed;
+    sensor_sampling_t sampling;
+    sensor_acquisition_source_t acquisition;
+    uint32_t last_acquisition_seq;
 } sensor_context_t;
 
 static sensor_context_t three_axis_sensors_def[] = {
     {
         .oid = 3313,
         .driver = &BSP_ACCELEROMETER_DRIVER,
-        .unit = "m/s2"
+        .unit = "m/s2",
+        .sampling = SENSOR_SAMPLING_INITIALIZER(
+                THREE_AXIS_SENSOR_DEFAULT_PERIOD_S,
+                SENSOR_SAMPLING_BACKGROUND_PERIOD_S)
     },
     {
         .oid = 3314,
         .driver = &BSP_MAGNETOMETER_DRIVER,
-        .unit = "T"
+        .unit = "T",
+        .sampling = SENSOR_SAMPLING_INITIALIZER(
+                THREE_AXIS_SENSOR_DEFAULT_PERIOD_S,
+                SENSOR_SAMPLING_BACKGROUND_PERIOD_S)
     },
     {
         .oid = 3334,
         .driver = &BSP_GYROMETER_DRIVER,
-        .unit = "deg/s"
+        .unit = "deg/s",
+        .sampling = SENSOR_SAMPLING_INITIALIZER(
+                THREE_AXIS_SENSOR_DEFAULT_PERIOD_S,
+                SENSOR_SAMPLING_BACKGROUND_PERIOD_S)
     }
 };
 
+// Called from the sensor acquisition task
+static int acquire_values(const void *_ctx,
+                          sensor_acquisition_sample_t *out_sample) {
+    const three_axis_sensor_driver_t *driver =
+            ((const sensor_context_t *) _ctx)->driver;
+
+    // With batching, the reported value is the average of all samples since
+    // the previous one; IPSO 3D sensors have no resources for min and max
+    three_axis_sensor_values_t values;
+    three_axis_sensor_window_t window;
+    if (driver->read_window && !driver->read_window(&window)) {
+        values = window.avg;
+    } else if (driver->read(&values)) {
+        return -1;
+    }
+
+    out_sample->values[0] = values.x;
+    out_sample->values[1] = values.y;
+    out_sample->values[2] = values.z;
+
+    return 0;
+}
+
+// Called from the sensor acquisition task
+static int set_power(const void *_ctx,
+                     sensor_power_state_t state,
+                     float odr_hz) {
+    const three_axis_sensor_driver_t *driver =
+            ((const sensor_context_t *) _ctx)->driver;
+
+    return driver->set_power_state(state, odr_hz);
+}
+
 static int read_values(anjay_iid_t iid,
                        void *_ctx,
                        double *x_value,
                        double *y_value,
                        double *z_value) {
-    const three_axis_sensor_driver_t *driver =
-            ((sensor_context_t *) _ctx)->driver;
+    sensor_context_t *ctx = (sensor_context_t *) _ctx;
 
-    three_axis_sensor_values_t out_values;
-    if (driver->read(&out_values)) {
+    sensor_acquisition_sample_t sample;
+    if (sensor_acquisition_get(&ctx->acquisition, &sample)) {
         return -1;
     }
 
-    *x_value = (double) out_values.x;
-    *y_value = (double) out_values.y;
-    *z_value = (double) out_values.z;
+    *x_value = (double) sample.values[0];
+    *y_value = (double) sample.values[1];
+    *z_value = (double) sample.values[2];
 
     return 0;
 }
@@ -71,6 +125,10 @@ void three_axis_sensor_objects_install(anjay_t *anjay) {
         sensor_context_t *ctx = &three_axis_sensors_def[i];
 
         if (ctx->driver->init()
+                || sensor_acquisition_register(
+                           &ctx->acquisition, acquire_values,
+                           ctx->driver->set_power_state ? set_power : NULL,
+                           ctx)
                 || anjay_ipso_3d_sensor_install(anjay, ctx->oid, 1)) {
             continue;
         }
@@ -95,8 +153,40 @@ void three_axis_sensor_objects_update(anjay_t *anjay) {
     for (int i = 0; i < AVS_ARRAY_SIZE(three_axis_sensors_def); i++) {
         sensor_context_t *ctx = &three_axis_sensors_def[i];
 
-        if (ctx->installed) {
+        if (!ctx->installed) {
+            continue;
+        }
+
+        if (sensor_acquisition_has_new_sample(&ctx->acquisition,
+                                              &ctx->last_acquisition_seq)) {
             anjay_ipso_3d_sensor_update(anjay, ctx->oid, 0);
+#ifdef ANJAY_WITH_SEND
+            sensor_acquisition_sample_t sample;
+            if (!sensor_acquisition_get(&ctx->acquisition, &sample)) {
+                for (size_t j = 0;
+                     j < AVS_ARRAY_SIZE(THREE_AXIS_SENSOR_SAMPLED_RIDS);
+                     j++) {
+                    lwm2m_send_batch_add_double(
+                            anjay, ctx->oid, 0,
+                            THREE_AXIS_SENSOR_SAMPLED_RIDS[j],
+                            (double) sample.values[j]);
+                }
+            }
+#endif // ANJAY_WITH_SEND
         }
+
+        // Reported during the next call, see lwm2m_notify_job()
+        if (sensor_sampling_is_due(
+                    anjay, &ctx->sampling, ctx->oid, 0,
+                    THREE_AXIS_SENSOR_SAMPLED_RIDS,
+                    AVS_ARRAY_SIZE(THREE_AXIS_SENSOR_SAMPLED_RIDS))) {
+            sensor_acquisition_request(&ctx->acquisition);
+        }
+
+        // Applied before the requested sample is acquired, if any
+        float odr_hz;
+        sensor_power_state_t state =
+                sensor_sampling_power_state(&ctx->sampling, &odr_hz);
+        sensor_acquisition_set_power(&ctx->acquisition, state, odr_hz);
     }
 }
@@ -68,6 +68,9 @@ void persistence_clear(void) {
     if (nvm_partition_clear(NVM_PARTITION_MODULES)) {
         LOG(ERROR, "Failed to clear modules partition");
     }
+#ifdef ANJAY_WITH_CORE_PERSISTENCE
+    persistence_core_clear();
+#endif // ANJAY_WITH_CORE_PERSISTENCE
 }
 
 
@@ -163,3 +166,72 @@ int persistence_mod_persist_if_required(anjay_t *anjay) {
     return 0;
 }
 
+#ifdef ANJAY_WITH_CORE_PERSISTENCE
+static anjay_t *try_core_restore(const anjay_configuration_t *config) {
+    avs_stream_t *stream;
+    if (nvm_partition_stream_input_open(NVM_PARTITION_CORE, &stream)) {
+        LOG(ERROR, "Failed to open core partition stream");
+        return NULL;
+    }
+    if (!stream) {
+        LOG(INFO, "No core state to resume");
+        return NULL;
+    }
+
+    anjay_t *anjay = anjay_new_from_core_persistence(config, stream);
+    if (avs_is_err(avs_stream_cleanup(&stream))) {
+        LOG(ERROR, "Failed to cleanup core partition stream");
+    }
+    if (!anjay) {
+        LOG(WARNING, "Failed to resume stored core state, discarding it");
+    }
+    // Resuming the same DTLS session state again, e.g. after a watchdog
+    // reset, would reuse record sequence numbers already seen by the server,
+    // and a corrupted state would be rejected again on every boot
+    persistence_core_clear();
+    return anjay;
+}
+
+void persistence_core_clear(void) {
+    if (nvm_partition_clear(NVM_PARTITION_CORE)) {
+        LOG(ERROR, "Failed to clear core partition");
+    }
+}
+
+anjay_t *persistence_core_restore(const anjay_configuration_t *config) {
+    anjay_t *anjay = try_core_restore(config);
+    if (anjay) {
+        LOG(INFO, "Resumed core state from persistence");
+        return anjay;
+    }
+    return anjay_new(config);
+}
+
+int persistence_core_persist_and_delete(anjay_t *anjay) {
+    avs_stream_t *stream;
+    if (nvm_partition_stream_output_open(NVM_PARTITION_CORE, &stream)
+            || !stream) {
+        LOG(ERROR, "Failed to open core partition stream");
+        anjay_delete(anjay);
+        return -1;
+    }
+
+    bool persist_failed =
+            avs_is_err(anjay_delete_with_core_persistence(anjay, stream));
+    if (persist_failed) {
+        LOG(ERROR, "Failed to persist core state");
+    }
+
+    if (avs_is_err(avs_stream_cleanup(&stream)) || persist_failed) {
+        return -1;
+    }
+
+    if (nvm_partition_mark_valid(NVM_PARTITION_CORE)) {
+        LOG(ERROR, "Failed to mark the core partition valid");
+        return -1;
+    }
+
+    LOG(INFO, "Successfully persisted core state");
+    return 0;
+}
+#endif // ANJAY_WITH_CORE_PERSISTENCE
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <anjay/core.h>
+#include <avsystem/commons/avs_defs.h>
+#include <avsystem/commons/avs_log.h>
+#include <avsystem/commons/avs_time.h>
+
+#include "plf_config.h"
+#include "power_coordinator.h"
+
+#if (USE_LOW_POWER == 1)
+#include "cellular_control_api.h"
+
+#define LOG(level, ...) avs_log(power_coordinator, level, __VA_ARGS__)
+
+// T3412 extended value, i.e. GPRS Timer 3 (3GPP TS 24.008, 10.5.7.4a): bits 8-6
+// encode the unit, bits 5-1 the multiplier
+#define T3412_MULTIPLIER_MAX 31
+#define T3412_DEACTIVATED 0xE0U
+
+// Sorted by increasing unit duration
+static const struct {
+    uint8_t unit_bits;
+    int64_t unit_s;
+} T3412_UNITS[] = {
+    { 0x60U, 2 },     { 0x80U, 30 },    { 0xA0U, 60 },     { 0x00U, 600 },
+    { 0x20U, 3600 },  { 0x40U, 36000 }, { 0xC0U, 1152000 }
+};
+
+typedef struct {
+    ca_power_mode_t mode;
+    // Requested T3412, meaningful only if mode enables PSM
+    uint8_t periodic_tau;
+} power_setting_t;
+
+// Setting passed to the cellular service, initially its default one
+static power_setting_t g_applied = {
+    .mode = DC_POWER_MODE_DEFAULT,
+    .periodic_tau = DC_POWER_PSM_REQ_PERIODIC_TAU_DEFAULT
+};
+// Setting matching the last measured gap, applied at the next exchange
+static power_setting_t g_requested = {
+    .mode = DC_POWER_MODE_DEFAULT,
+    .periodic_tau = DC_POWER_PSM_REQ_PERIODIC_TAU_DEFAULT
+};
+// Whether the gap of the current idle period has already been measured
+static bool g_idle;
+
+/**
+ * Returns the shortest T3412 value which is not shorter than @p seconds.
+ */
+static uint8_t t3412_from_seconds(int64_t seconds) {
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(T3412_UNITS); i++) {
+        int64_t multiplier =
+                (seconds + T3412_UNITS[i].unit_s - 1) / T3412_UNITS[i].unit_s;
+        if (multiplier <= T3412_MULTIPLIER_MAX) {
+            return (uint8_t) (T3412_UNITS[i].unit_bits | multiplier);
+        }
+    }
+    return T3412_DEACTIVATED;
+}
+
+static bool setting_equal(const power_setting_t *a,
+                          const power_setting_t *b) {
+    return a->mode == b->mode
+           && (a->mode != CA_POWER_LP || a->periodic_tau == b->periodic_tau);
+}
+
+static void apply_requested_setting(void) {
+    if (setting_equal(&g_applied, &g_requested)) {
+        return;
+    }
+
+    bool low_power = (g_requested.mode == CA_POWER_LP);
+    cellular_power_config_t config = {
+        .power_cmd = CA_POWER_CMD_SETTING,
+        .power_mode = g_requested.mode,
+        .psm_present = true,
+        .edrx_present = true,
+        .psm_mode = low_power ? CA_PSM_MODE_ENABLE : CA_PSM_MODE_DISABLE,
+        .sleep_request_timeout = DC_POWER_SLEEP_REQUEST_TIMEOUT_DEFAULT,
+        .psm = {
+            .req_periodic_RAU = DC_POWER_PSM_REQ_PERIODIC_RAU_DEFAULT,
+            .req_GPRS_READY_timer = DC_POWER_PSM_REQ_GPRS_READY_TIMER_DEFAULT,
+            .req_periodic_TAU = g_requested.periodic_tau,
+            .req_active_time = DC_POWER_PSM_REQ_ACTIVE_TIMER_DEFAULT
+        },
+        .eidrx_mode = low_power ? CA_EIDRX_MODE_ENABLE : CA_EIDRX_MODE_DISABLE,
+        .eidrx = {
+            .act_type = DC_POWER_EDRX_ACT_TYPE_DEFAULT,
+            .req_value = DC_POWER_EDRX_REQ_VALUE_DEFAULT
+        }
+    };
+    if (cellular_set_power(&config) != CELLULAR_SUCCESS) {
+        LOG(WARNING, "failed to set power config, retrying at next exchange");
+        return;
+    }
+    LOG(INFO, "power mode %d, periodic TAU 0x%02x", (int) g_requested.mode,
+        (unsigned) g_requested.periodic_tau);
+    g_applied = g_requested;
+}
+
+void power_coordinator_update(anjay_t *anjay) {
+    if (anjay_get_sockets(anjay)) {
+        // The modem is awake for an exchange anyway
+        g_idle = false;
+        apply_requested_setting();
+        return;
+    }
+    if (g_idle) {
+        return;
+    }
+
+    avs_time_duration_t gap;
+    int64_t gap_s;
+    if (anjay_sched_time_to_next(anjay, &gap)
+            || avs_time_duration_to_scalar(&gap_s, AVS_TIME_S, gap)) {
+        // Nothing planned, e.g. registration was abandoned
+        return;
+    }
+    g_idle = true;
+
+    if (gap_s >= POWER_COORDINATOR_MIN_PSM_S) {
+        g_requested.mode = CA_POWER_LP;
+        g_requested.periodic_tau = t3412_from_seconds(gap_s);
+    } else {
+        // Not worth the PSM entry and exit cost, data idle only
+        g_requested.mode = CA_POWER_IDLE;
+    }
+    LOG(DEBUG, "idle for %ld s", (long) gap_s);
+}
+#endif // (USE_LOW_POWER == 1)
@@ -0,0 +1,245 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmsis_os.h>
+
+#include <avsystem/commons/avs_log.h>
+
+#include <error_handler.h>
+
+#include "plf_config.h"
+#include "sensor_acquisition.h"
+
+#define LOG(level, ...) avs_log(sensor_acquisition, level, __VA_ARGS__)
+
+#define SENSOR_ACQUISITION_MAX_SOURCES 8
+#define SENSOR_ACQUISITION_MAX_WORKS 2
+#define SENSOR_ACQUISITION_SIGNAL 0x01
+// A reader is only disturbed by the lower priority acquisition task, so more
+// attempts than that are never expected to be needed
+#define SENSOR_ACQUISITION_GET_ATTEMPTS 3
+// Power state kept in the top 8 bits, output data rate in mHz in the rest
+#define SENSOR_ACQUISITION_POWER_ODR_BITS 24
+#define SENSOR_ACQUISITION_POWER_ODR_MAX_MHZ \
+    ((UINT32_C(1) << SENSOR_ACQUISITION_POWER_ODR_BITS) - 1)
+// Sensor left in the state its driver initialized it in
+#define SENSOR_ACQUISITION_POWER_INITIAL UINT32_MAX
+
+static osThreadId g_sensor_acquisition_task_handle;
+
+static sensor_acquisition_source_t *g_sources[SENSOR_ACQUISITION_MAX_SOURCES];
+static atomic_size_t g_sources_count;
+
+static sensor_acquisition_work_t *g_works[SENSOR_ACQUISITION_MAX_WORKS];
+static atomic_size_t g_works_count;
+
+static void acquire(sensor_acquisition_source_t *source) {
+    uint_fast32_t seq =
+            atomic_load_explicit(&source->seq, memory_order_relaxed);
+    // Readers only copy buf[seq % 2], the other buffer can be freely written
+    sensor_acquisition_sample_t *sample = &source->buf[(seq + 1) % 2];
+    if (source->read(source->arg, sample)) {
+        return;
+    }
+    atomic_store_explicit(&source->seq, seq + 1, memory_order_release);
+}
+
+static uint32_t encode_power(sensor_power_state_t state, float odr_hz) {
+    float odr_mhz = odr_hz * 1000.0f;
+    uint32_t odr = 0;
+    if (odr_mhz >= (float) SENSOR_ACQUISITION_POWER_ODR_MAX_MHZ) {
+        odr = SENSOR_ACQUISITION_POWER_ODR_MAX_MHZ;
+    } else if (odr_mhz > 0.0f) {
+        odr = (uint32_t) odr_mhz;
+    }
+    return ((uint32_t) state << SENSOR_ACQUISITION_POWER_ODR_BITS) | odr;
+}
+
+static void apply_power(sensor_acquisition_source_t *source) {
+    uint32_t request = (uint32_t) atomic_load(&source->power_request);
+    if (request == source->power_applied) {
+        return;
+    }
+    sensor_power_state_t state =
+            (sensor_power_state_t) (request
+                                    >> SENSOR_ACQUISITION_POWER_ODR_BITS);
+    float odr_hz =
+            (float) (request & SENSOR_ACQUISITION_POWER_ODR_MAX_MHZ) / 1000.0f;
+    if (source->set_power(source->arg, state, odr_hz)) {
+        LOG(WARNING, "could not change sensor power state to %d", (int) state);
+    }
+    // Not retried on failure, a sensor in an unknown state is read anyway
+    source->power_applied = request;
+}
+
+static void sensor_acquisition_thread(void const *user_arg) {
+    (void) user_arg;
+
+    for (;;) {
+        (void) osSignalWait(SENSOR_ACQUISITION_SIGNAL, osWaitForever);
+
+        size_t works_count = atomic_load(&g_works_count);
+        for (size_t i = 0; i < works_count; i++) {
+            if (atomic_exchange(&g_works[i]->scheduled, false)) {
+                g_works[i]->handler();
+            }
+        }
+
+        size_t count = atomic_load(&g_sources_count);
+        for (size_t i = 0; i < count; i++) {
+            if (g_sources[i]->set_power) {
+                apply_power(g_sources[i]);
+            }
+            if (atomic_exchange(&g_sources[i]->requested, false)) {
+                acquire(g_sources[i]);
+            }
+        }
+    }
+}
+
+int sensor_acquisition_register(sensor_acquisition_source_t *source,
+                                sensor_acquisition_read_t *read,
+                                sensor_acquisition_set_power_t *set_power,
+                                const void *arg) {
+    size_t count = atomic_load(&g_sources_count);
+    if (count >= SENSOR_ACQUISITION_MAX_SOURCES) {
+        LOG(ERROR, "too many sensor acquisition sources");
+        return -1;
+    }
+
+    source->read = read;
+    source->set_power = set_power;
+    source->arg = arg;
+    atomic_init(&source->requested, false);
+    atomic_init(&source->power_request, SENSOR_ACQUISITION_POWER_INITIAL);
+    source->power_applied = SENSOR_ACQUISITION_POWER_INITIAL;
+    atomic_init(&source->seq, 0);
+    // Not visible to the acquisition task yet, so it can be read from here
+    acquire(source);
+
+    g_sources[count] = source;
+    atomic_store(&g_sources_count, count + 1);
+    return 0;
+}
+
+void sensor_acquisition_request(sensor_acquisition_source_t *source) {
+    atomic_store(&source->requested, true);
+    if (g_sensor_acquisition_task_handle) {
+        (void) osSignalSet(g_sensor_acquisition_task_handle,
+                           SENSOR_ACQUISITION_SIGNAL);
+    }
+}
+
+void sensor_acquisition_set_power(sensor_acquisition_source_t *source,
+                                  sensor_power_state_t state,
+                                  float odr_hz) {
+    if (!source->set_power) {
+        return;
+    }
+    uint32_t request = encode_power(state, odr_hz);
+    if ((uint32_t) atomic_exchange(&source->power_request, request)
+            != request
+            && g_sensor_acquisition_task_handle) {
+        (void) osSignalSet(g_sensor_acquisition_task_handle,
+                           SENSOR_ACQUISITION_SIGNAL);
+    }
+}
+
+int sensor_acquisition_register_work(
+        sensor_acquisition_work_t *work,
+        sensor_acquisition_work_handler_t *handler) {
+    size_t count = atomic_load(&g_works_count);
+    if (count >= SENSOR_ACQUISITION_MAX_WORKS) {
+        LOG(ERROR, "too many sensor acquisition works");
+        return -1;
+    }
+
+    work->handler = handler;
+    atomic_init(&work->scheduled, false);
+
+    g_works[count] = work;
+    atomic_store(&g_works_count, count + 1);
+    return 0;
+}
+
+void sensor_acquisition_schedule_work(sensor_acquisition_work_t *work) {
+    atomic_store(&work->scheduled, true);
+    // osSignalSet() takes care of being called from an interrupt handler
+    if (g_sensor_acquisition_task_handle) {
+        (void) osSignalSet(g_sensor_acquisition_task_handle,
+                           SENSOR_ACQUISITION_SIGNAL);
+    }
+}
+
+int sensor_acquisition_get(sensor_acquisition_source_t *source,
+                           sensor_acquisition_sample_t *out_sample) {
+    for (int attempt = 0; attempt < SENSOR_ACQUISITION_GET_ATTEMPTS;
+         attempt++) {
+        uint_fast32_t seq =
+                atomic_load_explicit(&source->seq, memory_order_acquire);
+        if (seq == 0) {
+            return -1;
+        }
+        *out_sample = source->buf[seq % 2];
+        atomic_thread_fence(memory_order_acquire);
+        // buf[seq % 2] is written again only after seq + 1 is published
+        if (atomic_load_explicit(&source->seq, memory_order_relaxed) == seq) {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+bool sensor_acquisition_has_new_sample(sensor_acquisition_source_t *source,
+                                       uint32_t *last_seq) {
+    uint32_t seq = (uint32_t) atomic_load(&source->seq);
+    if (seq == *last_seq) {
+        return false;
+    }
+    *last_seq = seq;
+    return true;
+}
+
+void sensor_acquisition_init(void) {
+    atomic_init(&g_sources_count, 0);
+    atomic_init(&g_works_count, 0);
+}
+
+static uint32_t
+        sensor_acquisition_thread_stack_buffer[SENSOR_ACQUISITION_THREAD_STACK_SIZE];
+static osStaticThreadDef_t sensor_acquisition_thread_controlblock;
+void sensor_acquisition_start(void) {
+    osThreadStaticDef(sensor_acquisition_task, sensor_acquisition_thread,
+                      SENSOR_ACQUISITION_THREAD_PRIO, 0,
+                      SENSOR_ACQUISITION_THREAD_STACK_SIZE,
+                      sensor_acquisition_thread_stack_buffer,
+                      &sensor_acquisition_thread_controlblock);
+    g_sensor_acquisition_task_handle =
+            osThreadCreate(osThread(sensor_acquisition_task), NULL);
+
+    if (!g_sensor_acquisition_task_handle) {
+        LOG(ERROR, "failed to create thread");
+        ERROR_Handler(DBG_CHAN_APPLICATION, 0, ERROR_FATAL);
+    }
+    // Serve requests made before the task existed
+    (void) osSignalSet(g_sensor_acquisition_task_handle,
+                       SENSOR_ACQUISITION_SIGNAL);
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <anjay/anjay.h>
+#include <anjay/dm.h>
+#include <avsystem/commons/avs_time.h>
+
+#include "sensor_sampling.h"
+
+/**
+ * Returns the sampling period in seconds required by the observations of the
+ * given resource, or a negative value if the resource is not observed.
+ */
+static int32_t required_period_s(anjay_t *anjay,
+                                 const sensor_sampling_t *sampling,
+                                 anjay_oid_t oid,
+                                 anjay_iid_t iid,
+                                 anjay_rid_t rid) {
+    anjay_resource_observation_status_t status =
+            anjay_resource_observation_status(anjay, oid, iid, rid);
+    if (!status.is_observed) {
+        return -1;
+    }
+
+    // No change can be notified before pmin, so there is no point in sampling
+    // more often
+    int32_t period = status.min_period > 0 ? status.min_period
+                                           : sampling->default_period_s;
+    // epmax requires the value to be evaluated at least that often
+    if (status.max_eval_period > 0 && status.max_eval_period < period) {
+        period = status.max_eval_period;
+    }
+    return period;
+}
+
+/**
+ * Returns the first multiple of @p period_s on the monotonic clock after
+ * @p now. All sensors sampled with commensurable periods thus become due in the
+ * same cycle, no matter when their observations were established, so that
+ * their changes are reported together, e.g. in a single Observe-Composite
+ * notification.
+ */
+static avs_time_monotonic_t next_sample_time(avs_time_monotonic_t now,
+                                             int32_t period_s) {
+    int64_t now_s;
+    if (period_s <= 0
+            || avs_time_monotonic_to_scalar(&now_s, AVS_TIME_S, now)) {
+        return avs_time_monotonic_add(
+                now, avs_time_duration_from_scalar(period_s, AVS_TIME_S));
+    }
+    return avs_time_monotonic_from_scalar((now_s / period_s + 1) * period_s,
+                                          AVS_TIME_S);
+}
+
+bool sensor_sampling_is_due(anjay_t *anjay,
+                            sensor_sampling_t *sampling,
+                            anjay_oid_t oid,
+                            anjay_iid_t iid,
+                            const anjay_rid_t *rids,
+                            size_t rids_count) {
+    int32_t period_s = -1;
+    for (size_t i = 0; i < rids_count; i++) {
+        int32_t rid_period_s =
+                required_period_s(anjay, sampling, oid, iid, rids[i]);
+        if (rid_period_s >= 0 && (period_s < 0 || rid_period_s < period_s)) {
+            period_s = rid_period_s;
+        }
+    }
+
+    if (sampling->background_period_s > 0
+            && (period_s < 0 || sampling->background_period_s < period_s)) {
+        period_s = sampling->background_period_s;
+    }
+    sampling->period_s = period_s;
+
+    if (period_s < 0) {
+        // Not observed: sample as soon as an observation is established
+        sampling->scheduled = false;
+        return false;
+    }
+
+    avs_time_monotonic_t now = avs_time_monotonic_now();
+    avs_time_monotonic_t next_sample = next_sample_time(now, period_s);
+    if (sampling->scheduled
+            && avs_time_monotonic_before(now, sampling->next_sample)) {
+        // A tighter observation may have been established in the meantime
+        if (avs_time_monotonic_before(next_sample, sampling->next_sample)) {
+            sampling->next_sample = next_sample;
+        }
+        return false;
+    }
+
+    sampling->scheduled = true;
+    sampling->next_sample = next_sample;
+    return true;
+}
+
+sensor_power_state_t
+sensor_sampling_power_state(const sensor_sampling_t *sampling,
+                            float *out_odr_hz) {
+    if (sampling->period_s < 0) {
+        *out_odr_hz = 0.0f;
+        return SENSOR_POWER_OFF;
+    }
+    if (sampling->period_s < SENSOR_POWER_LOW_POWER_MIN_PERIOD_S) {
+        // A period of 0 means sampling in every cycle of the caller
+        *out_odr_hz = sampling->period_s > 0
+                              ? 1.0f / (float) sampling->period_s
+                              : 1.0f;
+        return SENSOR_POWER_ACTIVE;
+    }
+    *out_odr_hz = 0.0f;
+    return SENSOR_POWER_LOW_POWER;
+}
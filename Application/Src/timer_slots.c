@@ -0,0 +1,85 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <cmsis_os.h>
+
+#include "FreeRTOS.h"
+#include "main.h"
+#include "task.h"
+#include "timers.h"
+
+#include "plf_config.h"
+#include "timer_slots.h"
+
+static uint32_t now_ms(void) {
+    // The tick rate is 1 kHz, see FreeRTOSConfig.h
+    return (uint32_t) osKernelSysTick();
+}
+
+uint32_t timer_slots_periodic_delay_ms(uint32_t period_ms) {
+    uint32_t now = now_ms();
+    // Rounding to the nearest boundary keeps the phase of a job which runs
+    // slightly after (or before) the boundary it was planned for
+    uint32_t base = (now + TIMER_SLOTS_PERIOD_MS / 2) / TIMER_SLOTS_PERIOD_MS
+                    * TIMER_SLOTS_PERIOD_MS;
+    uint32_t next = base + period_ms;
+    while ((int32_t) (next - now) <= 0) {
+        next += period_ms;
+    }
+    return next - now;
+}
+
+uint32_t timer_slots_delay_ms(uint32_t delay_ms, uint32_t slack_ms) {
+    uint32_t remainder = (now_ms() + delay_ms) % TIMER_SLOTS_PERIOD_MS;
+    if (remainder == 0) {
+        return delay_ms;
+    }
+    uint32_t extension = TIMER_SLOTS_PERIOD_MS - remainder;
+    return extension <= slack_ms ? delay_ms + extension : delay_ms;
+}
+
+uint32_t timer_slots_default_slack_ms(uint32_t delay_ms) {
+    uint32_t slack_ms = delay_ms / 100U * TIMER_SLOTS_SLACK_PERCENT;
+    return slack_ms < TIMER_SLOTS_MAX_SLACK_MS ? slack_ms
+                                               : TIMER_SLOTS_MAX_SLACK_MS;
+}
+
+osStatus timer_slots_timer_start(osTimerId timer_id, uint32_t millisec) {
+    bool periodic = (uxTimerGetReloadMode(timer_id) != pdFALSE);
+    if (!periodic) {
+        return osTimerStart(timer_id, timer_slots_delay_ms(
+                                              millisec,
+                                              timer_slots_default_slack_ms(
+                                                      millisec)));
+    }
+
+    osStatus status = osTimerStart(timer_id, millisec);
+    if (status != osOK || millisec < TIMER_SLOTS_PERIOD_MS
+            || __get_IPSR() != 0U) {
+        return status;
+    }
+    // The timer service computes the expiry as the start time plus the period,
+    // so restarting the timer as if at the last slot boundary makes it expire
+    // on boundaries. Expiring up to one slot early is harmless for polling.
+    TickType_t boundary = xTaskGetTickCount();
+    boundary -= boundary % pdMS_TO_TICKS(TIMER_SLOTS_PERIOD_MS);
+    (void) xTimerGenericCommand(timer_id, tmrCOMMAND_START, boundary, NULL, 0);
+    return status;
+}
@@ -94,6 +94,14 @@ at_action_rsp_t fRspAnalyze_QISTATE_BG96(at_context_t *p_at_ctxt, atcustom_modem
 at_action_rsp_t fRspAnalyze_QPING_BG96(at_context_t *p_at_ctxt, atcustom_modem_context_t *p_modem_ctxt,
                                        const IPC_RxMessage_t *p_msg_in, at_element_info_t *element_infos);
 
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+/* BG96 direct push mode: data received in +QIURC: "recv" */
+at_action_rsp_t fRspAnalyze_QIURC_recv_data_BG96(at_context_t *p_at_ctxt, atcustom_modem_context_t *p_modem_ctxt,
+                                                 const IPC_RxMessage_t *p_msg_in, at_element_info_t *element_infos);
+at_bool_t ATC_BG96_socket_pushrx_read(atcustom_modem_context_t *p_modem_ctxt);
+void ATC_BG96_socket_pushrx_flush(socket_handle_t sockHandle);
+#endif /* BG96_SOCKET_DIRECT_PUSH_MODE == 1U */
+
 /**
   * @}
   */
@@ -92,6 +92,20 @@ extern "C" {
 /* set default value */
 #define BG96_OPTION_ENGINEERING_MODE (0)
 #endif /* BG96_OPTION_ENGINEERING_MODE */
+
+#if !defined(BG96_SOCKET_DIRECT_PUSH_MODE)
+/* set default value: buffer access mode */
+#define BG96_SOCKET_DIRECT_PUSH_MODE (0U)
+#endif /* BG96_SOCKET_DIRECT_PUSH_MODE */
+
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+#if !defined(BG96_PUSH_RX_DATAGRAMS)
+/* number of maximum size datagrams (MODEM_MAX_SOCKET_RX_DATA_SIZE) the read-ahead buffer storing socket data
+ * pushed by the modem can hold, e.g. a block-wise transfer overlapping a notification and a retransmission
+ */
+#define BG96_PUSH_RX_DATAGRAMS (3U)
+#endif /* BG96_PUSH_RX_DATAGRAMS */
+#endif /* BG96_SOCKET_DIRECT_PUSH_MODE == 1U */
 /**
   * @}
   */
@@ -382,6 +396,18 @@ typedef struct
   AT_CHAR_t hostIPaddr[MAX_SIZE_IPADDR]; /* = host_name parameter from CS_DnsReq_t */
 } bg96_qiurc_dnsgip_t;
 
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+typedef struct
+{
+  at_bool_t        payload_expected; /* indicate that next message received contains the pushed data */
+  socket_handle_t  sock_handle;      /* from <connectID> */
+  uint32_t         size;             /* <currentrecvlength> */
+  CS_IPaddrType_t  ip_addr_type;
+  AT_CHAR_t        ip_addr_value[MAX_IP_ADDR_SIZE]; /* <remoteIP> (UDP service only) */
+  uint16_t         remote_port;      /* <remote_port> (UDP service only) */
+} bg96_qiurc_recv_t;
+#endif /* (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U) */
+
 typedef struct
 {
   ATCustom_BG96_mode_band_config_t  mode_and_bands_config;  /* memorize current BG96 mode and bands configuration */
@@ -397,6 +423,9 @@ typedef struct
   uint8_t                    bg96_sim_status_retries; /* memorize number of attempts to access SIM (with QINISTAT) */
 #if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM)
   at_bool_t                  pdn_already_active; /* check if request PDN to activate is already active (QIACT) */
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+  bg96_qiurc_recv_t          QIURC_recv_param;   /* memorize infos received in the URC +QIURC:"recv" header */
+#endif /* BG96_SOCKET_DIRECT_PUSH_MODE == 1U */
 #endif /* USE_SOCKETS_TYPE */
 
 #if (ENABLE_BG96_LOW_POWER_MODE != 0U)
@@ -57,6 +57,16 @@ extern "C" {
 #define CONFIG_MODEM_MAX_SIM_GENERIC_ACCESS_CMD_SIZE ((uint32_t)1460U)
 #define CONFIG_MODEM_MIN_SIM_GENERIC_ACCESS_RSP_SIZE ((uint32_t)4U)
 
+/* Socket data receive mode:
+ * 0 = buffer access mode: +QIURC: "recv" only notifies, data are read with AT+QIRD
+ * 1 = direct push mode: data are pushed by the modem inside the +QIURC: "recv" URC
+ *     and stored in a read-ahead buffer, which saves one AT+QIRD exchange per packet.
+ *     A datagram which does not fit in the buffer is dropped, a TCP socket whose data do not fit
+ *     is reported as closed.
+ *     Not validated on a modem yet, hence disabled by default.
+ */
+#define BG96_SOCKET_DIRECT_PUSH_MODE         (0U)
+
 /* Ping URC received before or after Reply */
 #define PING_URC_RECEIVED_AFTER_REPLY        (1U)
 
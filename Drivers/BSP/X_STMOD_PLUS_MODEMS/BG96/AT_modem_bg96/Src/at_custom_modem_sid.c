@@ -1939,6 +1939,25 @@ static at_status_t at_SID_CS_RECEIVE_DATA(atcustom_modem_context_t *p_mdm_ctxt,
 
   at_status_t retval = ATSTATUS_OK;
 
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+  if CHECK_STEP((0U))
+  {
+    /* Direct push mode: data have already been received with +QIURC: "recv" and stored in the
+     * read-ahead buffer, no command to send to the modem.
+     */
+    if (ATC_BG96_socket_pushrx_read(p_mdm_ctxt) == AT_FALSE)
+    {
+      /* no more data pending for this socket */
+      atcm_socket_clear_available_data_flag(p_mdm_ctxt);
+    }
+    atcm_program_NO_MORE_CMD(p_atp_ctxt);
+  }
+  else
+  {
+    /* error, invalid step */
+    retval = ATSTATUS_ERROR;
+  }
+#else
   if CHECK_STEP((0U))
   {
     /* Request size of data only if an URC indicating that data are available has been received.
@@ -1990,6 +2009,7 @@ static at_status_t at_SID_CS_RECEIVE_DATA(atcustom_modem_context_t *p_mdm_ctxt,
     /* error, invalid step */
     retval = ATSTATUS_ERROR;
   }
+#endif /* BG96_SOCKET_DIRECT_PUSH_MODE == 1U */
 
   return (retval);
 }
@@ -2014,6 +2034,10 @@ static at_status_t at_SID_CS_SOCKET_CLOSE(atcustom_modem_context_t *p_mdm_ctxt,
   {
     if CHECK_STEP((0U))
     {
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+      /* data pushed by the modem and not read by the client are lost */
+      ATC_BG96_socket_pushrx_flush(p_mdm_ctxt->socket_ctxt.p_socket_info->socket_handle);
+#endif /* BG96_SOCKET_DIRECT_PUSH_MODE == 1U */
       /* is socket connected ?
         * due to BG96 socket connection mechanism (waiting URC QIOPEN), we can fall here but socket
         * has been already closed if error occurs during connection
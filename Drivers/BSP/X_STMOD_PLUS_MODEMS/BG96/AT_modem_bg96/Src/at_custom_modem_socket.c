@@ -94,11 +94,59 @@
   * @}
   */
 
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+/** @defgroup AT_CUSTOM_QUECTEL_BG96_SOCKET_Private_Types AT_CUSTOM QUECTEL_BG96 SOCKET Private Types
+  * @{
+  */
+/* Header of a record stored in the read-ahead buffer, followed by <size> bytes of data */
+typedef struct
+{
+  socket_handle_t  sock_handle;
+  uint32_t         size;
+  uint16_t         remote_port;
+  CS_IPaddrType_t  ip_addr_type;
+  AT_CHAR_t        ip_addr_value[MAX_IP_ADDR_SIZE];
+} bg96_pushrx_header_t;
+/**
+  * @}
+  */
+
+/** @defgroup AT_CUSTOM_QUECTEL_BG96_SOCKET_Private_Variables AT_CUSTOM QUECTEL_BG96 SOCKET Private Variables
+  * @{
+  */
+/* Read-ahead buffer: data pushed by the modem are stored here until the client reads them.
+ * Records are stored in reception order, a record is removed when it has been fully read.
+ * Accessed only from the AT parser (ATCore parsing mutex).
+ */
+#define BG96_PUSH_RX_BUFFER_SIZE \
+  ((uint32_t)BG96_PUSH_RX_DATAGRAMS * ((uint32_t)sizeof(bg96_pushrx_header_t) + MODEM_MAX_SOCKET_RX_DATA_SIZE))
+static uint8_t  bg96_pushrx_buffer[BG96_PUSH_RX_BUFFER_SIZE];
+static uint32_t bg96_pushrx_used = 0U;
+/* TCP sockets whose pushed data did not fit in the read-ahead buffer: they have been reported as closed
+ * and data pushed for them are discarded until the client closes them.
+ */
+static bool     bg96_pushrx_overflow[CELLULAR_MAX_SOCKETS];
+/* Sockets opened as TCP: a gap would corrupt their byte stream, unlike a lost datagram */
+static bool     bg96_pushrx_stream[CELLULAR_MAX_SOCKETS];
+/* Datagrams dropped because they did not fit in the read-ahead buffer */
+static uint32_t bg96_pushrx_dropped_datagrams = 0U;
+/**
+  * @}
+  */
+#endif /* BG96_SOCKET_DIRECT_PUSH_MODE == 1U */
+
 /** @defgroup AT_CUSTOM_QUECTEL_BG96_SOCKET_Private_Functions_Prototypes
   *    AT_CUSTOM QUECTEL_BG96 SOCKET Private Functions Prototypes
   * @{
   */
 static void clear_ping_resp_struct(atcustom_modem_context_t *p_modem_ctxt);
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+static void pushrx_remove_data(uint32_t record_offset, uint32_t size_to_remove);
+static bool pushrx_is_overflow(socket_handle_t sockHandle);
+static void pushrx_set_overflow(socket_handle_t sockHandle, bool overflow);
+static bool pushrx_is_stream(socket_handle_t sockHandle);
+static void pushrx_set_stream(socket_handle_t sockHandle, bool stream);
+#endif /* BG96_SOCKET_DIRECT_PUSH_MODE == 1U */
 /**
   * @}
   */
@@ -207,7 +255,15 @@ at_status_t fCmdBuild_QIOPEN_BG96(atparser_context_t *p_atp_ctxt, atcustom_modem
                                                           p_modem_ctxt->socket_ctxt.p_socket_info->conf_id);
       PRINT_DBG("user cid = %d, PDP modem cid = %d",
                 (uint8_t)p_modem_ctxt->socket_ctxt.p_socket_info->conf_id, pdp_modem_cid)
-      uint8_t access_mode = 0U; /* 0=buffer access mode, 1=direct push mode, 2=transparent access mode */
+      /* 0=buffer access mode, 1=direct push mode, 2=transparent access mode */
+      uint8_t access_mode = (BG96_SOCKET_DIRECT_PUSH_MODE == 1U) ? 1U : 0U;
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+      if (p_modem_ctxt->socket_ctxt.p_socket_info->trp_connect_mode == CS_CM_ONLINE_MODE)
+      {
+        /* modem answers CONNECT and switches to data mode once the socket is opened */
+        access_mode = 2U;
+      }
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
 
       if (p_atp_ctxt->current_SID == (at_msg_t) SID_CS_DIAL_COMMAND)
       {
@@ -225,6 +281,10 @@ at_status_t fCmdBuild_QIOPEN_BG96(atparser_context_t *p_atp_ctxt, atcustom_modem
           service_type_index = ((p_modem_ctxt->socket_ctxt.p_socket_info->protocol) == CS_TCP_PROTOCOL) ? \
                                ATSOCKET_SERVICETYPE_TCP_CLIENT : ATSOCKET_SERVICETYPE_UDP_CLIENT;
         }
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+        pushrx_set_stream(p_modem_ctxt->socket_ctxt.p_socket_info->socket_handle,
+                          (p_modem_ctxt->socket_ctxt.p_socket_info->protocol == CS_TCP_PROTOCOL));
+#endif /* BG96_SOCKET_DIRECT_PUSH_MODE == 1U */
 
         (void) sprintf((CRC_CHAR_t *)p_atp_ctxt->current_atcmd.params, "%d,%ld,\"%s\",\"%s\",%d,%d,%d",
                        pdp_modem_cid,
@@ -773,10 +833,17 @@ at_action_rsp_t fRspAnalyze_QIURC_BG96(at_context_t *p_at_ctxt, atcustom_modem_c
         /* <connectID> */
         connectID = ATutil_convertStringToInt(&p_msg_in->buffer[element_infos->str_start_idx], element_infos->str_size);
         sockHandle = atcm_socket_get_socket_handle(p_modem_ctxt, connectID);
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+        /* direct push mode: data follow the URC header, client is notified once they are stored */
+        (void) memset((void *)&bg96_shared.QIURC_recv_param, 0, sizeof(bg96_qiurc_recv_t));
+        bg96_shared.QIURC_recv_param.sock_handle = sockHandle;
+        PRINT_DBG("+QIURC data pushed for connId=%ld (socket handle=%ld)", connectID, sockHandle)
+#else
         (void) atcm_socket_set_urc_data_pending(p_modem_ctxt, sockHandle);
         PRINT_DBG("+QIURC received data for connId=%ld (socket handle=%ld)", connectID, sockHandle)
         /* last param */
         retval = ATACTION_RSP_URC_FORWARDED;
+#endif /* BG96_SOCKET_DIRECT_PUSH_MODE == 1U */
         break;
 
       case QIURC_CLOSED:
@@ -923,7 +990,22 @@ at_action_rsp_t fRspAnalyze_QIURC_BG96(at_context_t *p_at_ctxt, atcustom_modem_c
         }
         break;
 
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
       case QIURC_RECV:
+        /* <currentrecvlength>: data will be received in next message */
+        bg96_shared.QIURC_recv_param.size =
+          ATutil_convertStringToInt(&p_msg_in->buffer[element_infos->str_start_idx], element_infos->str_size);
+        bg96_shared.QIURC_recv_param.payload_expected =
+          (bg96_shared.QIURC_recv_param.size != 0U) ? AT_TRUE : AT_FALSE;
+        PRINT_DBG("+QIURC data pushed size=%ld", bg96_shared.QIURC_recv_param.size)
+        /* last param for TCP, the URC will be forwarded when data have been received */
+        retval = ATACTION_RSP_URC_IGNORED;
+        break;
+
+#endif /* BG96_SOCKET_DIRECT_PUSH_MODE == 1U */
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 0U)
+      case QIURC_RECV:
+#endif /* BG96_SOCKET_DIRECT_PUSH_MODE == 0U */
       case QIURC_CLOSED:
       case QIURC_PDPDEACT:
       case QIURC_INCOMING_FULL:
@@ -960,7 +1042,21 @@ at_action_rsp_t fRspAnalyze_QIURC_BG96(at_context_t *p_at_ctxt, atcustom_modem_c
         }
         break;
 
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+      case QIURC_RECV:
+        /* <remoteIP> (UDP service only) */
+        (void) memcpy((void *)&bg96_shared.QIURC_recv_param.ip_addr_value[0],
+                      (const void *) & (p_msg_in->buffer[element_infos->str_start_idx]),
+                      (size_t)((element_infos->str_size < (MAX_IP_ADDR_SIZE - 1U)) ?
+                               element_infos->str_size : (MAX_IP_ADDR_SIZE - 1U)));
+        bg96_shared.QIURC_recv_param.ip_addr_type =
+          atcm_get_ip_address_type((AT_CHAR_t *)&bg96_shared.QIURC_recv_param.ip_addr_value);
+        break;
+
+#endif /* BG96_SOCKET_DIRECT_PUSH_MODE == 1U */
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 0U)
       case QIURC_RECV:
+#endif /* BG96_SOCKET_DIRECT_PUSH_MODE == 0U */
       case QIURC_CLOSED:
       case QIURC_PDPDEACT:
       case QIURC_INCOMING_FULL:
@@ -982,7 +1078,18 @@ at_action_rsp_t fRspAnalyze_QIURC_BG96(at_context_t *p_at_ctxt, atcustom_modem_c
         retval = ATACTION_RSP_URC_FORWARDED;
         break;
 
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+      case QIURC_RECV:
+        /* <remote_port> (UDP service only) */
+        bg96_shared.QIURC_recv_param.remote_port =
+          (uint16_t) ATutil_convertStringToInt(&p_msg_in->buffer[element_infos->str_start_idx],
+                                               element_infos->str_size);
+        break;
+
+#endif /* BG96_SOCKET_DIRECT_PUSH_MODE == 1U */
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 0U)
       case QIURC_RECV:
+#endif /* BG96_SOCKET_DIRECT_PUSH_MODE == 0U */
       case QIURC_CLOSED:
       case QIURC_PDPDEACT:
       case QIURC_INCOMING_FULL:
@@ -1345,6 +1452,191 @@ at_action_rsp_t fRspAnalyze_QIRD_data_BG96(at_context_t *p_at_ctxt, atcustom_mod
   return (retval);
 }
 
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+/**
+  * @brief  Analyze specific modem URC : QIURC "recv" (data part, direct push mode).
+  * @param  p_atp_ctxt Pointer to the structure of Parser context.
+  * @param  p_modem_ctxt Pointer to the structure of Modem context.
+  * @retval at_action_rsp_t
+  */
+at_action_rsp_t fRspAnalyze_QIURC_recv_data_BG96(at_context_t *p_at_ctxt, atcustom_modem_context_t *p_modem_ctxt,
+                                                 const IPC_RxMessage_t *p_msg_in, at_element_info_t *element_infos)
+{
+  UNUSED(p_at_ctxt);
+  at_action_rsp_t retval = ATACTION_RSP_URC_IGNORED;
+  bg96_pushrx_header_t header;
+  uint32_t record_size = (uint32_t)sizeof(bg96_pushrx_header_t) + (uint32_t)element_infos->str_size;
+  PRINT_API("enter fRspAnalyze_QIURC_recv_data_BG96()")
+
+  /* data payload received, next messages are analyzed normally */
+  bg96_shared.QIURC_recv_param.payload_expected = AT_FALSE;
+
+  PRINT_DBG("DATA pushed: size=%ld vs %d", bg96_shared.QIURC_recv_param.size, element_infos->str_size)
+
+  if (bg96_shared.QIURC_recv_param.sock_handle == CS_INVALID_SOCKET_HANDLE)
+  {
+    PRINT_ERR("data pushed for an unknown socket: ignored")
+  }
+  else if (pushrx_is_overflow(bg96_shared.QIURC_recv_param.sock_handle))
+  {
+    PRINT_DBG("data pushed for a socket reported as closed: ignored")
+  }
+  else if (((bg96_pushrx_used + record_size) > BG96_PUSH_RX_BUFFER_SIZE)
+           && (!pushrx_is_stream(bg96_shared.QIURC_recv_param.sock_handle)))
+  {
+    /* client does not read data fast enough: BG96_PUSH_RX_DATAGRAMS is too small.
+     * Datagrams may be lost on the way anyway, so the whole datagram is dropped and the socket stays open.
+     */
+    bg96_pushrx_dropped_datagrams++;
+    PRINT_ERR("read-ahead buffer full: datagram of %d bytes for socket %ld dropped (%ld dropped so far)",
+              element_infos->str_size, bg96_shared.QIURC_recv_param.sock_handle, bg96_pushrx_dropped_datagrams)
+  }
+  else if ((bg96_pushrx_used + record_size) > BG96_PUSH_RX_BUFFER_SIZE)
+  {
+    /* client does not read data fast enough: BG96_PUSH_RX_DATAGRAMS is too small.
+     * Dropping these data would silently corrupt the byte stream of a TCP socket, so the socket is
+     * reported as closed by remote instead: the client gets an error and has to open a new one.
+     */
+    PRINT_ERR("read-ahead buffer full: socket %ld reported as closed", bg96_shared.QIURC_recv_param.sock_handle)
+    ATC_BG96_socket_pushrx_flush(bg96_shared.QIURC_recv_param.sock_handle);
+    pushrx_set_overflow(bg96_shared.QIURC_recv_param.sock_handle, true);
+    (void) atcm_socket_set_urc_closed_by_remote(p_modem_ctxt, bg96_shared.QIURC_recv_param.sock_handle);
+    retval = ATACTION_RSP_URC_FORWARDED;
+  }
+  else
+  {
+    /* store a new record: header then data */
+    (void) memset((void *)&header, 0, sizeof(bg96_pushrx_header_t));
+    header.sock_handle = bg96_shared.QIURC_recv_param.sock_handle;
+    header.size = (uint32_t)element_infos->str_size;
+    header.remote_port = bg96_shared.QIURC_recv_param.remote_port;
+    header.ip_addr_type = bg96_shared.QIURC_recv_param.ip_addr_type;
+    (void) memcpy((void *)&header.ip_addr_value[0],
+                  (const void *)&bg96_shared.QIURC_recv_param.ip_addr_value[0],
+                  (size_t) MAX_IP_ADDR_SIZE);
+
+    (void) memcpy((void *)&bg96_pushrx_buffer[bg96_pushrx_used], (const void *)&header,
+                  sizeof(bg96_pushrx_header_t));
+    (void) memcpy((void *)&bg96_pushrx_buffer[bg96_pushrx_used + sizeof(bg96_pushrx_header_t)],
+                  (const void *)&p_msg_in->buffer[element_infos->str_start_idx],
+                  (size_t) element_infos->str_size);
+    bg96_pushrx_used += record_size;
+
+    /* inform client that data are available */
+    (void) atcm_socket_set_urc_data_pending(p_modem_ctxt, header.sock_handle);
+    retval = ATACTION_RSP_URC_FORWARDED;
+  }
+
+  return (retval);
+}
+
+/**
+  * @brief  Read data pushed by the modem for the socket requested by the client.
+  * @note   Oldest record of the socket is copied to client buffer. If client buffer is too small,
+  *         remaining data are kept for next read.
+  * @param  p_modem_ctxt Pointer to the structure of Modem context.
+  * @retval at_bool_t Returns AT_TRUE if more data are available for this socket.
+  */
+at_bool_t ATC_BG96_socket_pushrx_read(atcustom_modem_context_t *p_modem_ctxt)
+{
+  at_bool_t more_data = AT_FALSE;
+  bool record_read = false;
+  uint32_t offset = 0U;
+  bg96_pushrx_header_t header;
+  csint_socket_data_buffer_t *p_rcv = &p_modem_ctxt->socket_ctxt.socketReceivedata;
+
+  p_rcv->buffer_size = 0U;
+
+  while (offset < bg96_pushrx_used)
+  {
+    (void) memcpy((void *)&header, (const void *)&bg96_pushrx_buffer[offset], sizeof(bg96_pushrx_header_t));
+    if (header.sock_handle == p_rcv->socket_handle)
+    {
+      if (record_read)
+      {
+        /* another record is waiting for this socket */
+        more_data = AT_TRUE;
+        offset = bg96_pushrx_used; /* exit loop */
+      }
+      else if (p_rcv->p_buffer_addr_rcv != NULL)
+      {
+        uint32_t size = (header.size > p_rcv->max_buffer_size) ? p_rcv->max_buffer_size : header.size;
+        (void) memcpy((void *)p_rcv->p_buffer_addr_rcv,
+                      (const void *)&bg96_pushrx_buffer[offset + sizeof(bg96_pushrx_header_t)],
+                      (size_t) size);
+        p_rcv->buffer_size = size;
+        p_rcv->remote_port = header.remote_port;
+        p_rcv->ip_addr_type = header.ip_addr_type;
+        (void) memcpy((void *)&p_rcv->ip_addr_value[0], (const void *)&header.ip_addr_value[0],
+                      (size_t) MAX_IP_ADDR_SIZE);
+        record_read = true;
+
+        if (size < header.size)
+        {
+          PRINT_INFO("Data size available (%ld) exceed buffer maximum size (%ld)", header.size, size)
+          /* keep remaining data in this record */
+          header.size -= size;
+          (void) memcpy((void *)&bg96_pushrx_buffer[offset], (const void *)&header, sizeof(bg96_pushrx_header_t));
+          pushrx_remove_data(offset + sizeof(bg96_pushrx_header_t), size);
+          more_data = AT_TRUE;
+          offset = bg96_pushrx_used; /* exit loop */
+        }
+        else
+        {
+          /* record fully read: remove it, next record is now at same offset */
+          pushrx_remove_data(offset, (uint32_t)sizeof(bg96_pushrx_header_t) + header.size);
+        }
+      }
+      else
+      {
+        PRINT_ERR("receive buffer is a NULL ptr")
+        offset = bg96_pushrx_used; /* exit loop */
+      }
+    }
+    else
+    {
+      /* record for another socket */
+      offset += (uint32_t)sizeof(bg96_pushrx_header_t) + header.size;
+    }
+  }
+
+  return (more_data);
+}
+
+/**
+  * @brief  Discard data pushed by the modem and not yet read.
+  * @param  sockHandle Socket handle (CS_INVALID_SOCKET_HANDLE to discard data of all sockets).
+  * @retval none.
+  */
+void ATC_BG96_socket_pushrx_flush(socket_handle_t sockHandle)
+{
+  uint32_t offset = 0U;
+  bg96_pushrx_header_t header;
+
+  if (sockHandle == CS_INVALID_SOCKET_HANDLE)
+  {
+    bg96_pushrx_used = 0U;
+    (void) memset((void *)&bg96_pushrx_overflow[0], 0, sizeof(bg96_pushrx_overflow));
+  }
+  else
+  {
+    pushrx_set_overflow(sockHandle, false);
+    while (offset < bg96_pushrx_used)
+    {
+      (void) memcpy((void *)&header, (const void *)&bg96_pushrx_buffer[offset], sizeof(bg96_pushrx_header_t));
+      if (header.sock_handle == sockHandle)
+      {
+        pushrx_remove_data(offset, (uint32_t)sizeof(bg96_pushrx_header_t) + header.size);
+      }
+      else
+      {
+        offset += (uint32_t)sizeof(bg96_pushrx_header_t) + header.size;
+      }
+    }
+  }
+}
+#endif /* BG96_SOCKET_DIRECT_PUSH_MODE == 1U */
+
 /**
   * @brief  Analyze specific modem response : QISTATE.
   * @param  p_atp_ctxt Pointer to the structure of Parser context.
@@ -1660,6 +1952,77 @@ static void clear_ping_resp_struct(atcustom_modem_context_t *p_modem_ctxt)
   p_modem_ctxt->persist.ping_resp_urc.index = saved_idx;
 }
 
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+/**
+  * @brief  Remove bytes from the read-ahead buffer and compact it.
+  * @param  record_offset Offset of first byte to remove.
+  * @param  size_to_remove Number of bytes to remove.
+  * @retval none
+  */
+static void pushrx_remove_data(uint32_t record_offset, uint32_t size_to_remove)
+{
+  uint32_t tail_offset = record_offset + size_to_remove;
+
+  if (tail_offset < bg96_pushrx_used)
+  {
+    (void) memmove((void *)&bg96_pushrx_buffer[record_offset],
+                   (const void *)&bg96_pushrx_buffer[tail_offset],
+                   (size_t)(bg96_pushrx_used - tail_offset));
+  }
+  bg96_pushrx_used -= size_to_remove;
+}
+
+/**
+  * @brief  Check if pushed data of a socket did not fit in the read-ahead buffer.
+  * @param  sockHandle Socket handle.
+  * @retval bool Returns true if the socket has been reported as closed because of an overflow.
+  */
+static bool pushrx_is_overflow(socket_handle_t sockHandle)
+{
+  return (((sockHandle >= 0) && ((uint32_t)sockHandle < CELLULAR_MAX_SOCKETS)) ?
+          bg96_pushrx_overflow[sockHandle] : false);
+}
+
+/**
+  * @brief  Set or clear the read-ahead buffer overflow state of a socket.
+  * @param  sockHandle Socket handle.
+  * @param  overflow New state.
+  * @retval none
+  */
+static void pushrx_set_overflow(socket_handle_t sockHandle, bool overflow)
+{
+  if ((sockHandle >= 0) && ((uint32_t)sockHandle < CELLULAR_MAX_SOCKETS))
+  {
+    bg96_pushrx_overflow[sockHandle] = overflow;
+  }
+}
+
+/**
+  * @brief  Check if a socket has been opened as a TCP socket.
+  * @param  sockHandle Socket handle.
+  * @retval bool Returns true for a TCP socket, false for a UDP socket.
+  */
+static bool pushrx_is_stream(socket_handle_t sockHandle)
+{
+  return (((sockHandle >= 0) && ((uint32_t)sockHandle < CELLULAR_MAX_SOCKETS)) ?
+          bg96_pushrx_stream[sockHandle] : false);
+}
+
+/**
+  * @brief  Record the protocol of a socket being opened.
+  * @param  sockHandle Socket handle.
+  * @param  stream True for a TCP socket, false for a UDP socket.
+  * @retval none
+  */
+static void pushrx_set_stream(socket_handle_t sockHandle, bool stream)
+{
+  if ((sockHandle >= 0) && ((uint32_t)sockHandle < CELLULAR_MAX_SOCKETS))
+  {
+    bg96_pushrx_stream[sockHandle] = stream;
+  }
+}
+#endif /* BG96_SOCKET_DIRECT_PUSH_MODE == 1U */
+
 /**
   * @}
   */
@@ -94,6 +94,16 @@ static atcustom_modem_context_t BG96_ctxt;
 static AT_CHAR_t SocketHeaderDataRx_Buf[4];
 static uint8_t SocketHeaderDataRx_Cpt;
 static uint8_t SocketHeaderDataRx_Cpt_Complete;
+
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+/* Socket Data pushed by the modem (direct push mode): to analyze +QIURC: "recv" header and count data */
+static uint8_t  SocketPushRx_PrefixCpt;      /* number of chars of +QIURC: "recv", prefix matched */
+static uint8_t  SocketPushRx_FieldCpt;       /* number of fields separators received after the prefix */
+static uint8_t  SocketPushRx_HeaderReceived; /* 1 if a complete +QIURC: "recv" header has been received */
+static uint8_t  SocketPushRx_ReceivingData;  /* 1 while counting pushed data */
+static uint32_t SocketPushRx_ExpectedSize;
+static uint32_t SocketPushRx_CountBytes;
+#endif /* (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U) */
 /**
   * @}
   */
@@ -132,6 +142,10 @@ static void bg96_modem_init(atcustom_modem_context_t *p_modem_ctxt);
 static void socketHeaderRX_reset(void);
 static void SocketHeaderRX_addChar(CRC_CHAR_t *rxchar);
 static uint16_t SocketHeaderRX_getSize(void);
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+static void socketPushRX_reset(void);
+static void socketPushRX_analyzeHeaderChar(uint8_t rxChar);
+#endif /* (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U) */
 
 static void display_decoded_GSM_bands(uint32_t gsm_bands);
 static void display_decoded_CatM1_bands(uint32_t CatM1_bands_MsbPart, uint32_t CatM1_bands_LsbPart);
@@ -329,11 +343,34 @@ uint8_t ATCustom_BG96_checkEndOfMsgCallback(uint8_t rxChar)
       BG96_ctxt.state_SyntaxAutomaton = WAITING_FOR_FIRST_CHAR;
       last_char = 1U;
       QIRD_Counter = 0U;
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+      if ((SocketPushRx_HeaderReceived == 1U) && (SocketPushRx_ExpectedSize != 0U))
+      {
+        /* +QIURC: "recv",<connectID>,<currentrecvlength><CR><LF> has been received:
+        *  header message is complete, next chars are the pushed data (not analyzed, only counted)
+        */
+        SocketPushRx_ReceivingData = 1U;
+        SocketPushRx_CountBytes = 0U;
+        BG96_ctxt.state_SyntaxAutomaton = WAITING_FOR_SOCKET_DATA;
+      }
+      SocketPushRx_PrefixCpt = 0U;
+      SocketPushRx_FieldCpt = 0U;
+      SocketPushRx_HeaderReceived = 0U;
+#endif /* (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U) */
     }
   }
   /*---------------------------------------------------------------------------------------*/
   else if (BG96_ctxt.state_SyntaxAutomaton == WAITING_FOR_FIRST_CHAR)
   {
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+    /* Socket Data pushed by the modem: look for +QIURC: "recv" header in every line received
+    *
+    * +QIURC: "recv",0,522<CR><LF>HTTP/1.1 200 OK<CR><LF><CR><LF>Date: Wed, 21 Feb 2018 14:56:54 GMT<CR><LF>...
+    *                  ^- retrieving this size
+    */
+    socketPushRX_analyzeHeaderChar(rxChar);
+
+#endif /* (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U) */
     if (BG96_ctxt.socket_ctxt.socket_RxData_state == SocketRxDataState_waiting_header)
     {
       /* Socket Data RX - waiting for Header: we are waiting for +QIRD
@@ -434,6 +471,30 @@ uint8_t ATCustom_BG96_checkEndOfMsgCallback(uint8_t rxChar)
   /*---------------------------------------------------------------------------------------*/
   else if (BG96_ctxt.state_SyntaxAutomaton == WAITING_FOR_SOCKET_DATA)
   {
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+    if (SocketPushRx_ReceivingData == 1U)
+    {
+      /* receiving pushed socket data: do not analyze char, just count expected size */
+      SocketPushRx_CountBytes++;
+      if (SocketPushRx_CountBytes == SocketPushRx_ExpectedSize)
+      {
+        /* full pushed data received, data message will be closed by next <CR><LF> */
+        SocketPushRx_ReceivingData = 0U;
+        BG96_ctxt.state_SyntaxAutomaton = WAITING_FOR_CR;
+      }
+    }
+    else
+    {
+      BG96_ctxt.socket_ctxt.socket_rx_count_bytes_received++;
+      /* check if full buffer has been received */
+      if (BG96_ctxt.socket_ctxt.socket_rx_count_bytes_received ==
+          BG96_ctxt.socket_ctxt.socket_rx_expected_buf_size)
+      {
+        BG96_ctxt.socket_ctxt.socket_RxData_state = SocketRxDataState_data_received;
+        BG96_ctxt.state_SyntaxAutomaton = WAITING_FOR_CR;
+      }
+    }
+#else
     BG96_ctxt.socket_ctxt.socket_rx_count_bytes_received++;
     /* check if full buffer has been received */
     if (BG96_ctxt.socket_ctxt.socket_rx_count_bytes_received == BG96_ctxt.socket_ctxt.socket_rx_expected_buf_size)
@@ -441,6 +502,7 @@ uint8_t ATCustom_BG96_checkEndOfMsgCallback(uint8_t rxChar)
       BG96_ctxt.socket_ctxt.socket_RxData_state = SocketRxDataState_data_received;
       BG96_ctxt.state_SyntaxAutomaton = WAITING_FOR_CR;
     }
+#endif /* (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U) */
   }
   /*---------------------------------------------------------------------------------------*/
   else
@@ -452,7 +514,12 @@ uint8_t ATCustom_BG96_checkEndOfMsgCallback(uint8_t rxChar)
   /* if modem does not use standard syntax or has some specificities, replace previous
   *  function by a custom function
   */
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+  /* pushed socket data can contain any char: do not try to detect socket prompt inside */
+  if ((last_char == 0U) && (SocketPushRx_ReceivingData == 0U))
+#else
   if (last_char == 0U)
+#endif /* (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U) */
   {
     /* BG96 special cases
     *
@@ -618,7 +685,20 @@ at_endmsg_t ATCustom_BG96_extractElement(atparser_context_t *p_atp_ctxt,
     }
 
 #if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM)
-    exit_loop = false;
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+    if (bg96_shared.QIURC_recv_param.payload_expected == AT_TRUE)
+    {
+      /* this message contains the data pushed after +QIURC: "recv" header: take it as a single element */
+      uint16_t push_size = (bg96_shared.QIURC_recv_param.size < (uint32_t)p_msg_in->size) ?
+                           (uint16_t)bg96_shared.QIURC_recv_param.size : p_msg_in->size;
+      PRINT_DBG("receiving pushed socket data (size=%d)", push_size)
+      element_infos->str_start_idx = 0U;
+      element_infos->str_end_idx = push_size;
+      element_infos->str_size = push_size;
+      retval_msg_end_detected = ATENDMSG_YES;
+    }
+#endif /* (BG96_SOCKET_DIRECT_PUSH_MODE == 1U) */
+    exit_loop = (retval_msg_end_detected == ATENDMSG_YES) ? true : false;
     for (uint16_t idx = *p_parseIndex; (idx < (p_msg_in->size - 1U)) && (exit_loop == false); idx++)
     {
       if ((p_atp_ctxt->current_atcmd.id == (CMD_ID_t) CMD_AT_QIRD) &&
@@ -768,6 +848,14 @@ at_action_rsp_t ATCustom_BG96_analyzeCmd(at_context_t *p_at_ctxt,
 #if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM)
   bool no_valid_command_found;
 
+#if (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+  if (bg96_shared.QIURC_recv_param.payload_expected == AT_TRUE)
+  {
+    /* receiving data pushed by the modem: do not analyze received data (ie do not search in the LUT) */
+    no_valid_command_found = true;
+  }
+  else
+#endif /* (BG96_SOCKET_DIRECT_PUSH_MODE == 1U) */
   if (BG96_ctxt.socket_ctxt.socket_receive_state == SocketRcvState_RequestData_Payload)
   {
     /* receiving data payload on a socket: do not analyze received date (ie do not search in the LUT) */
@@ -807,7 +895,23 @@ at_action_rsp_t ATCustom_BG96_analyzeCmd(at_context_t *p_at_ctxt,
     /* 1st STEP: search in common modems commands
      * (CGMI, CGMM, CGMR, CGSN, GSN, IPR, CIMI, CGPADDR, ...)
      */
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+    if (bg96_shared.QIURC_recv_param.payload_expected == AT_TRUE)
+    {
+      /* The 2nd part of an URC in direct push mode, corresponding to the data, falls here:
+       *   +QIURC: "recv",0,522<CR><LF>
+       *   HTTP/1.1 200 OK<CR><LF><CR><LF>Date: Wed, 21 Feb 2018 14:56:54 GMT<CR><LF><CR><LF>Serve...
+       * Data are stored in the read-ahead buffer until the client reads them.
+       */
+      retval = fRspAnalyze_QIURC_recv_data_BG96(p_at_ctxt, &BG96_ctxt, p_msg_in, element_infos);
+    }
+    else
+    {
+      retval = atcm_check_text_line_cmd(&BG96_ctxt, p_at_ctxt, p_msg_in, element_infos);
+    }
+#else
     retval = atcm_check_text_line_cmd(&BG96_ctxt, p_at_ctxt, p_msg_in, element_infos);
+#endif /* (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U) */
 
     /* 2nd STEP: search in specific modems commands if not found at 1st STEP
      *
@@ -1245,6 +1349,25 @@ at_action_rsp_t ATCustom_BG96_terminateCmd(atparser_context_t *p_atp_ctxt, at_el
       retval = ATACTION_RSP_ERROR;
     }
   }
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (USE_SOCKETS_ONLINE_MODE == 1)
+  else if ((p_atp_ctxt->current_atcmd.id == (at_msg_t) CMD_AT_QIOPEN) &&
+           (element_infos->cmd_id_received == (at_msg_t) CMD_AT_CONNECT))
+  {
+    /* AT+QIOPEN in transparent access mode: CONNECT replaces OK and +QIOPEN URC.
+     * Socket is connected and modem is now in data mode, no other command can be sent.
+     */
+    if (BG96_ctxt.socket_ctxt.p_socket_info != NULL)
+    {
+      (void) atcm_socket_set_connected(&BG96_ctxt, BG96_ctxt.socket_ctxt.p_socket_info->socket_handle);
+    }
+    p_atp_ctxt->is_final_cmd = 1U;
+    PRINT_INFO("socket opened in transparent access mode")
+  }
+#endif /* (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (USE_SOCKETS_ONLINE_MODE == 1) */
+  else
+  {
+    /* nothing to do */
+  }
 
   /* ###########################  END CUSTOMIZATION PART  ########################### */
   return (retval);
@@ -1436,6 +1559,11 @@ void ATC_BG96_reset_variables(void)
   bg96_shared.modem_lp_state = MDM_LP_STATE_IDLE;
   bg96_shared.modem_resume_from_PSM = false;
 #endif /* (ENABLE_BG96_LOW_POWER_MODE == 1U) */
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+  /* data pushed before the reset are lost */
+  bg96_shared.QIURC_recv_param.payload_expected = AT_FALSE;
+  ATC_BG96_socket_pushrx_flush(CS_INVALID_SOCKET_HANDLE);
+#endif /* (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U) */
 }
 
 /**
@@ -1445,6 +1573,9 @@ void ATC_BG96_reset_variables(void)
 void ATC_BG96_reinitSyntaxAutomaton(atcustom_modem_context_t *p_modem_ctxt)
 {
   p_modem_ctxt->state_SyntaxAutomaton = WAITING_FOR_INIT_CR;
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+  socketPushRX_reset();
+#endif /* (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U) */
 }
 
 #if (ENABLE_BG96_LOW_POWER_MODE == 1U)
@@ -1833,6 +1964,72 @@ static uint16_t SocketHeaderRX_getSize(void)
   return (retval);
 }
 
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U)
+/**
+  * @brief  Reset state used to detect data pushed by the modem.
+  * @retval none.
+  */
+static void socketPushRX_reset(void)
+{
+  SocketPushRx_PrefixCpt = 0U;
+  SocketPushRx_FieldCpt = 0U;
+  SocketPushRx_HeaderReceived = 0U;
+  SocketPushRx_ReceivingData = 0U;
+  SocketPushRx_ExpectedSize = 0U;
+  SocketPushRx_CountBytes = 0U;
+}
+
+/**
+  * @brief  Analyze a char of a line to detect +QIURC: "recv" header and retrieve data size.
+  * @note   Called from checkEndOfMsgCallback (real time constraints): keep it short.
+  * @param  rxChar Character received from modem.
+  * @retval none.
+  */
+static void socketPushRX_analyzeHeaderChar(uint8_t rxChar)
+{
+  static const uint8_t QIURC_recv_string[] = "+QIURC: \"recv\",";
+  const uint8_t prefix_len = (uint8_t)(sizeof(QIURC_recv_string) - 1U);
+
+  if (SocketPushRx_PrefixCpt < prefix_len)
+  {
+    /* prefix not yet fully matched */
+    if (rxChar == QIURC_recv_string[SocketPushRx_PrefixCpt])
+    {
+      SocketPushRx_PrefixCpt++;
+      if (SocketPushRx_PrefixCpt == prefix_len)
+      {
+        SocketPushRx_FieldCpt = 0U;
+        SocketPushRx_ExpectedSize = 0U;
+      }
+    }
+    else
+    {
+      /* not a +QIURC: "recv" line, stop analyzing until next line */
+      SocketPushRx_PrefixCpt = 0xFFU;
+    }
+  }
+  else if (SocketPushRx_PrefixCpt == prefix_len)
+  {
+    /* +QIURC: "recv",<connectID>,<currentrecvlength>[,"<remoteIP>",<remote_port>]<CR><LF> */
+    if ((AT_CHAR_t)('\r') == rxChar)
+    {
+      SocketPushRx_HeaderReceived = (SocketPushRx_FieldCpt != 0U) ? 1U : 0U;
+    }
+    else if ((AT_CHAR_t)(',') == rxChar)
+    {
+      SocketPushRx_FieldCpt++;
+    }
+    else if ((SocketPushRx_FieldCpt == 1U) && (rxChar >= (AT_CHAR_t)('0')) && (rxChar <= (AT_CHAR_t)('9')))
+    {
+      /* receiving <currentrecvlength> */
+      SocketPushRx_ExpectedSize = (SocketPushRx_ExpectedSize * 10U) + (uint32_t)(rxChar - (AT_CHAR_t)('0'));
+    }
+    else {/* nothing to do */ }
+  }
+  else {/* nothing to do */ }
+}
+#endif /* (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (BG96_SOCKET_DIRECT_PUSH_MODE == 1U) */
+
 /**
   * @brief  Decode and display GSM bands
   * @param gsm_bands Bitmap for GSM bands.
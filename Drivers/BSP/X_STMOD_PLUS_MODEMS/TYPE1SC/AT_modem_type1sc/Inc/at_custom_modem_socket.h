@@ -91,6 +91,13 @@ at_action_rsp_t fRspAnalyze_PINGCMD(at_context_t *p_at_ctxt, atcustom_modem_cont
 
 /* TYPE1SC other exported functions */
 void clear_ping_resp_struct(atcustom_modem_context_t *p_modem_ctxt);
+#if (TYPE1SC_RX_READ_AHEAD_SIZE != 0U)
+at_bool_t ATC_TYPE1SC_readahead_read(atcustom_modem_context_t *p_modem_ctxt);
+uint32_t ATC_TYPE1SC_readahead_free_size(void);
+uint32_t ATC_TYPE1SC_readahead_commit(atcustom_modem_context_t *p_modem_ctxt);
+void ATC_TYPE1SC_readahead_abort(atcustom_modem_context_t *p_modem_ctxt);
+void ATC_TYPE1SC_readahead_flush(socket_handle_t sockHandle);
+#endif /* TYPE1SC_RX_READ_AHEAD_SIZE != 0U */
 
 /**
   * @}
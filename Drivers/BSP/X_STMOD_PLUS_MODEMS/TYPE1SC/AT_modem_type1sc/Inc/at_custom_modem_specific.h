@@ -50,6 +50,10 @@ extern "C" {
   * @{
   */
 #define MODEM_MAX_SOCKET_TX_DATA_SIZE   CONFIG_MODEM_MAX_SOCKET_TX_DATA_SIZE
+#if !defined(TYPE1SC_RX_READ_AHEAD_SIZE)
+/* set default value: no read-ahead */
+#define TYPE1SC_RX_READ_AHEAD_SIZE      (0U)
+#endif /* TYPE1SC_RX_READ_AHEAD_SIZE */
 #define MODEM_MAX_SOCKET_RX_DATA_SIZE   CONFIG_MODEM_MAX_SOCKET_RX_DATA_SIZE
 #define TYPE1SC_PING_LENGTH             ((uint16_t)56U)
 #define TYPE1SC_ACTIVATE_PING_REPORT    (1)
@@ -186,6 +190,11 @@ typedef struct
   bool                          modem_bootev_received;
   uint8_t                       notifyev_mode; /* define which NOTIFYEV are requested */
   bool                          modem_sim_same_as_selected;
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (TYPE1SC_RX_READ_AHEAD_SIZE != 0U)
+  uint32_t                      socket_rx_more_data;      /* <moreData> received in last %SOCKETDATA RECEIVE */
+  uint32_t                      socket_rx_drain_size;     /* size requested when draining modem RX buffer */
+  at_bool_t                     socket_rx_to_read_ahead;  /* current RECEIVE stores data in read-ahead buffer */
+#endif /* (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (TYPE1SC_RX_READ_AHEAD_SIZE != 0U) */
 
 #if (ENABLE_T1SC_LOW_POWER_MODE != 0U)
   /* low-power variables */
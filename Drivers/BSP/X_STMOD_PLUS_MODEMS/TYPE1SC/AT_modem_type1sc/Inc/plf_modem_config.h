@@ -87,6 +87,14 @@ extern "C" {
  */
 #define TYPE1SC_FASTEST_POWER_ON (0U)
 
+/* Socket receive read-ahead buffer size (in bytes, 0 to disable).
+ * When %SOCKETDATA="RECEIVE" reports that more data are left in the modem RX buffer (<moreData> field),
+ * these data are drained within the same receive request and stored in the read-ahead buffer.
+ * Next receive requests on this socket are served from this buffer without modem exchange.
+ * Not validated on a modem yet, hence disabled by default (3072U is the intended size).
+ */
+#define TYPE1SC_RX_READ_AHEAD_SIZE (0U)
+
 /**
   * @}
   */
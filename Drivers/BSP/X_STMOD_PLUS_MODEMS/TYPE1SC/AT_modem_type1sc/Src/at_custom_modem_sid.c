@@ -1917,6 +1917,16 @@ static at_status_t at_SID_CS_RECEIVE_DATA(atcustom_modem_context_t *p_mdm_ctxt,
 
   if CHECK_STEP((0U))
   {
+#if (TYPE1SC_RX_READ_AHEAD_SIZE != 0U)
+    type1sc_shared.socket_rx_more_data = 0U;
+    type1sc_shared.socket_rx_to_read_ahead = AT_FALSE;
+    if (ATC_TYPE1SC_readahead_read(p_mdm_ctxt) == AT_TRUE)
+    {
+      /* data already drained from the modem during a previous request: no command send to the modem */
+      atcm_program_NO_MORE_CMD(p_atp_ctxt);
+    }
+    else
+#endif /* TYPE1SC_RX_READ_AHEAD_SIZE != 0U */
     /* Request data only if an URC indicating that data are available has been received.
      * This is an optimization to avoid unnecessary modem communications in case the client
      * application calls this function without having received data notification.
@@ -1932,6 +1942,63 @@ static at_status_t at_SID_CS_RECEIVE_DATA(atcustom_modem_context_t *p_mdm_ctxt,
       atcm_program_NO_MORE_CMD(p_atp_ctxt);
     }
   }
+#if (TYPE1SC_RX_READ_AHEAD_SIZE != 0U)
+  else
+  {
+    /* step 1: response to client request received
+     * next steps: response to a drain request received
+     */
+    if (type1sc_shared.socket_rx_to_read_ahead == AT_TRUE)
+    {
+      /* store drained data in read-ahead buffer */
+      if (ATC_TYPE1SC_readahead_commit(p_mdm_ctxt) == 0U)
+      {
+        /* nothing drained: stop here */
+        type1sc_shared.socket_rx_more_data = 0U;
+      }
+    }
+    else if (p_mdm_ctxt->socket_ctxt.socketReceivedata.buffer_size == 0U)
+    {
+      /* reset data available flag if no data received */
+      atcm_socket_clear_available_data_flag(p_mdm_ctxt);
+    }
+    else
+    {
+      /* nothing to do */
+    }
+
+    /* drain data left in modem RX buffer (<moreData>) as long as they fit in read-ahead buffer,
+     * data available flag is kept set so next request will check modem RX buffer again if needed
+     */
+    uint32_t free_size = ATC_TYPE1SC_readahead_free_size();
+    if ((type1sc_shared.socket_rx_more_data != 0U) && (free_size != 0U))
+    {
+      type1sc_shared.socket_rx_drain_size = type1sc_shared.socket_rx_more_data;
+      if (type1sc_shared.socket_rx_drain_size > free_size)
+      {
+        type1sc_shared.socket_rx_drain_size = free_size;
+      }
+      if (type1sc_shared.socket_rx_drain_size > p_mdm_ctxt->socket_ctxt.socketReceivedata.max_buffer_size)
+      {
+        type1sc_shared.socket_rx_drain_size = p_mdm_ctxt->socket_ctxt.socketReceivedata.max_buffer_size;
+      }
+      PRINT_DBG("drain %ld bytes from modem RX buffer (%ld left)", type1sc_shared.socket_rx_drain_size,
+                type1sc_shared.socket_rx_more_data)
+      type1sc_shared.socket_rx_more_data = 0U;
+      type1sc_shared.socket_rx_to_read_ahead = AT_TRUE;
+      /* prepare an empty pending record */
+      (void) ATC_TYPE1SC_readahead_commit(p_mdm_ctxt);
+      atcm_program_AT_CMD(p_mdm_ctxt, p_atp_ctxt,
+                          ATTYPE_WRITE_CMD, (CMD_ID_t) CMD_AT_SOCKETDATA_RECEIVE, INTERMEDIATE_CMD);
+    }
+    else
+    {
+      type1sc_shared.socket_rx_to_read_ahead = AT_FALSE;
+      /* stop here, no more command send to the modem */
+      atcm_program_NO_MORE_CMD(p_atp_ctxt);
+    }
+  }
+#else
   else if CHECK_STEP((1U))
   {
     /* reset data available flag if no data received */
@@ -1947,6 +2014,7 @@ static at_status_t at_SID_CS_RECEIVE_DATA(atcustom_modem_context_t *p_mdm_ctxt,
     /* error, invalid step */
     retval = ATSTATUS_ERROR;
   }
+#endif /* TYPE1SC_RX_READ_AHEAD_SIZE != 0U */
 
   return (retval);
 }
@@ -1974,6 +2042,10 @@ static at_status_t at_SID_CS_SOCKET_CLOSE(atcustom_modem_context_t *p_mdm_ctxt,
    */
   if CHECK_STEP((0U))
   {
+#if (TYPE1SC_RX_READ_AHEAD_SIZE != 0U)
+    /* data drained from the modem and not read by the client are lost */
+    ATC_TYPE1SC_readahead_flush(p_mdm_ctxt->socket_ctxt.p_socket_info->socket_handle);
+#endif /* TYPE1SC_RX_READ_AHEAD_SIZE != 0U */
     type1sc_shared.SocketCmd_Delete_success = AT_FALSE;
     atcm_program_AT_CMD_ANSWER_OPTIONAL(p_mdm_ctxt, p_atp_ctxt, ATTYPE_WRITE_CMD,
                                         (CMD_ID_t) CMD_AT_SOCKETCMD_DEACTIVATE,
@@ -35,6 +35,7 @@
 
 #if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM)
 #include "at_modem_socket.h"
+#include "at_custom_modem_socket.h"
 #endif /* (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) */
 
 
@@ -635,6 +636,17 @@ at_action_rsp_t fRspAnalyze_Error_TYPE1SC(at_context_t *p_at_ctxt, atcustom_mode
         retval = fRspAnalyze_Error(p_at_ctxt, p_modem_ctxt, p_msg_in, element_infos);
       }
       break;
+
+#if (TYPE1SC_RX_READ_AHEAD_SIZE != 0U)
+    case CMD_AT_SOCKETDATA_RECEIVE:
+      if (type1sc_shared.socket_rx_to_read_ahead == AT_TRUE)
+      {
+        /* drain request rejected by the modem: error is reported to the client */
+        ATC_TYPE1SC_readahead_abort(p_modem_ctxt);
+      }
+      retval = fRspAnalyze_Error(p_at_ctxt, p_modem_ctxt, p_msg_in, element_infos);
+      break;
+#endif /* TYPE1SC_RX_READ_AHEAD_SIZE != 0U */
 #endif /* (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) */
 
     default:
@@ -94,6 +94,39 @@
   * @}
   */
 
+#if (TYPE1SC_RX_READ_AHEAD_SIZE != 0U)
+/** @defgroup AT_CUSTOM_ALTAIR_T1SC_SOCKET_Private_Types AT_CUSTOM ALTAIR_T1SC SOCKET Private Types
+  * @{
+  */
+/* Header of a record stored in the read-ahead buffer, followed by <size> bytes of data */
+typedef struct
+{
+  socket_handle_t  sock_handle;
+  uint32_t         size;
+  uint16_t         remote_port;
+  CS_IPaddrType_t  ip_addr_type;
+  CS_CHAR_t        ip_addr_value[MAX_IP_ADDR_SIZE];
+} type1sc_readahead_header_t;
+/**
+  * @}
+  */
+
+/** @defgroup AT_CUSTOM_ALTAIR_T1SC_SOCKET_Private_Variables AT_CUSTOM ALTAIR_T1SC SOCKET Private Variables
+  * @{
+  */
+/* Read-ahead buffer: data drained from the modem RX buffer are stored here until the client reads them.
+ * Records of all sockets are stored in reception order, each socket reads its own records in order.
+ * Accessed only from the AT parser (ATCore parsing mutex).
+ */
+static uint8_t  type1sc_readahead_buffer[TYPE1SC_RX_READ_AHEAD_SIZE];
+static uint32_t type1sc_readahead_used = 0U;
+/* header of the record being received (committed once the full response has been analyzed) */
+static type1sc_readahead_header_t type1sc_readahead_pending;
+/**
+  * @}
+  */
+#endif /* TYPE1SC_RX_READ_AHEAD_SIZE != 0U */
+
 
 /** @defgroup AT_CUSTOM_ALTAIR_T1SC_SOCKET_Private_Functions_Prototypes
   *  AT_CUSTOM ALTAIR_T1SC SOCKET Private Functions Prototypes
@@ -103,6 +136,9 @@ static uint8_t convertToASCII(uint8_t nbr);
 static void convertCharToHEX(uint8_t val, uint8_t *p_msd, uint8_t *p_lsd);
 static at_status_t convertDigitToValue(uint8_t digit, uint8_t *res);
 static at_status_t convertHEXToChar(uint8_t MSD, uint8_t LSD, uint8_t *res);
+#if (TYPE1SC_RX_READ_AHEAD_SIZE != 0U)
+static void readahead_remove_data(uint32_t record_offset, uint32_t size_to_remove);
+#endif /* TYPE1SC_RX_READ_AHEAD_SIZE != 0U */
 /**
   * @}
   */
@@ -510,6 +546,13 @@ at_status_t fCmdBuild_SOCKETDATA_RECEIVE(atparser_context_t *p_atp_ctxt, atcusto
                                                   p_modem_ctxt->socket_ctxt.socketReceivedata.socket_handle);
     uint32_t requested_data_size;
     requested_data_size = p_modem_ctxt->socket_ctxt.socketReceivedata.max_buffer_size;
+#if (TYPE1SC_RX_READ_AHEAD_SIZE != 0U)
+    if (type1sc_shared.socket_rx_to_read_ahead == AT_TRUE)
+    {
+      /* draining modem RX buffer: request only what fits in read-ahead buffer */
+      requested_data_size = type1sc_shared.socket_rx_drain_size;
+    }
+#endif /* TYPE1SC_RX_READ_AHEAD_SIZE != 0U */
     (void) sprintf((CRC_CHAR_t *)p_atp_ctxt->current_atcmd.params, "\"RECEIVE\",%ld,%ld",
                    socketID,
                    requested_data_size);
@@ -787,6 +830,27 @@ at_action_rsp_t fRspAnalyze_SOCKETDATA(at_context_t *p_at_ctxt, atcustom_modem_c
   at_action_rsp_t retval = ATACTION_RSP_IGNORED;
   PRINT_API("enter fRspAnalyze_SOCKETDATA()")
   uint32_t rlength = 0U;
+  /* destination of received data: client buffer or read-ahead buffer */
+  CS_CHAR_t *p_rcv_buffer = p_modem_ctxt->socket_ctxt.socketReceivedata.p_buffer_addr_rcv;
+  uint32_t rcv_buffer_max_size = p_modem_ctxt->socket_ctxt.socketReceivedata.max_buffer_size;
+  CS_CHAR_t *p_rcv_ip_addr = p_modem_ctxt->socket_ctxt.socketReceivedata.ip_addr_value;
+  CS_IPaddrType_t *p_rcv_ip_addr_type = &p_modem_ctxt->socket_ctxt.socketReceivedata.ip_addr_type;
+  uint16_t *p_rcv_remote_port = &p_modem_ctxt->socket_ctxt.socketReceivedata.remote_port;
+  uint32_t *p_rcv_size = &p_modem_ctxt->socket_ctxt.socketReceivedata.buffer_size;
+
+#if (TYPE1SC_RX_READ_AHEAD_SIZE != 0U)
+  if ((p_atp_ctxt->current_atcmd.id == (CMD_ID_t) CMD_AT_SOCKETDATA_RECEIVE) &&
+      (type1sc_shared.socket_rx_to_read_ahead == AT_TRUE))
+  {
+    /* draining modem RX buffer: data are written after the header of a new record */
+    p_rcv_buffer = (CS_CHAR_t *)&type1sc_readahead_buffer[type1sc_readahead_used + sizeof(type1sc_readahead_header_t)];
+    rcv_buffer_max_size = ATC_TYPE1SC_readahead_free_size();
+    p_rcv_ip_addr = type1sc_readahead_pending.ip_addr_value;
+    p_rcv_ip_addr_type = &type1sc_readahead_pending.ip_addr_type;
+    p_rcv_remote_port = &type1sc_readahead_pending.remote_port;
+    p_rcv_size = &type1sc_readahead_pending.size;
+  }
+#endif /* TYPE1SC_RX_READ_AHEAD_SIZE != 0U */
 
   /*
    *  for "SEND" command:
@@ -870,9 +934,17 @@ at_action_rsp_t fRspAnalyze_SOCKETDATA(at_context_t *p_at_ctxt, atcustom_modem_c
     }
     else if (element_infos->param_rank == 4U)
     {
-      /* <moreData> - only for information */
+      /* <moreData> */
+#if (TYPE1SC_RX_READ_AHEAD_SIZE != 0U)
+      /* memorize it to drain modem RX buffer in the same receive request */
+      type1sc_shared.socket_rx_more_data =
+        ATutil_convertStringToInt(&p_msg_in->buffer[element_infos->str_start_idx], element_infos->str_size);
+      PRINT_DBG("<SOCKETDATA_RECEIVE: moreData> = %ld", type1sc_shared.socket_rx_more_data)
+#else
+      /* only for information */
       PRINT_DBG("<SOCKETDATA_RECEIVE: moreData> = %ld",
                 ATutil_convertStringToInt(&p_msg_in->buffer[element_infos->str_start_idx], element_infos->str_size))
+#endif /* TYPE1SC_RX_READ_AHEAD_SIZE != 0U */
     }
     else if (element_infos->param_rank == 5U)
     {
@@ -890,7 +962,7 @@ at_action_rsp_t fRspAnalyze_SOCKETDATA(at_context_t *p_at_ctxt, atcustom_modem_c
       PRINT_DBG("<SOCKETDATA_RECEIVE: rdata> computed data_size = %d", data_size)
 
       /* check that received data size does not exceed client buffer size */
-      if (data_size <= p_modem_ctxt->socket_ctxt.socketReceivedata.max_buffer_size)
+      if (data_size <= rcv_buffer_max_size)
       {
         uint16_t idx;
         for (idx = 0U; ((idx < data_size) && (retval != ATACTION_RSP_ERROR)); idx++)
@@ -909,7 +981,7 @@ at_action_rsp_t fRspAnalyze_SOCKETDATA(at_context_t *p_at_ctxt, atcustom_modem_c
                                &conVal) == ATSTATUS_OK)
           {
             /* recopy data to client buffer */
-            p_modem_ctxt->socket_ctxt.socketReceivedata.p_buffer_addr_rcv[idx] = conVal;
+            p_rcv_buffer[idx] = conVal;
           }
           else
           {
@@ -920,42 +992,39 @@ at_action_rsp_t fRspAnalyze_SOCKETDATA(at_context_t *p_at_ctxt, atcustom_modem_c
         /* finally, update buffer client size */
         if (retval != ATACTION_RSP_ERROR)
         {
-          p_modem_ctxt->socket_ctxt.socketReceivedata.buffer_size = data_size;
+          *p_rcv_size = data_size;
           /* print buffer for DEBUG */
-          PRINT_BUF((const uint8_t *)&p_modem_ctxt->socket_ctxt.socketReceivedata.p_buffer_addr_rcv[0], data_size)
+          PRINT_BUF((const uint8_t *)&p_rcv_buffer[0], data_size)
         }
         else
         {
           PRINT_ERR("error occurred during string conversion")
           /* update buffer client size to zero */
-          p_modem_ctxt->socket_ctxt.socketReceivedata.buffer_size = 0;
+          *p_rcv_size = 0;
         }
       }
       else
       {
         /* error, size of received buffer exceed client size buffer */
-        PRINT_ERR("Size of received buffer (%d) exceed client buffer size (%ld)", data_size,
-                  p_modem_ctxt->socket_ctxt.socketReceivedata.max_buffer_size)
+        PRINT_ERR("Size of received buffer (%d) exceed client buffer size (%ld)", data_size, rcv_buffer_max_size)
         retval = ATACTION_RSP_ERROR;
       }
     }
     else if (element_infos->param_rank == 6U)
     {
       /* <src_ip = remoteIP> */
-      (void) memset((void *)&p_modem_ctxt->socket_ctxt.socketReceivedata.ip_addr_value[0],
-                    0, MAX_IP_ADDR_SIZE);
-      p_modem_ctxt->socket_ctxt.socketReceivedata.remote_port = 0U;
+      (void) memset((void *)&p_rcv_ip_addr[0], 0, MAX_IP_ADDR_SIZE);
+      *p_rcv_remote_port = 0U;
       atcm_extract_IP_address((const uint8_t *)&p_msg_in->buffer[element_infos->str_start_idx],
                               (uint16_t) element_infos->str_size,
-                              (uint8_t *)p_modem_ctxt->socket_ctxt.socketReceivedata.ip_addr_value);
+                              (uint8_t *)p_rcv_ip_addr);
       /* determine IP address type */
-      p_modem_ctxt->socket_ctxt.socketReceivedata.ip_addr_type =
-        atcm_get_ip_address_type((AT_CHAR_t *)&p_modem_ctxt->socket_ctxt.socketReceivedata.ip_addr_value);
+      *p_rcv_ip_addr_type = atcm_get_ip_address_type((AT_CHAR_t *)p_rcv_ip_addr);
     }
     else if (element_infos->param_rank == 7U)
     {
       /* <src_port = remotePort> */
-      p_modem_ctxt->socket_ctxt.socketReceivedata.remote_port =
+      *p_rcv_remote_port =
         (uint16_t) ATutil_convertStringToInt(&p_msg_in->buffer[element_infos->str_start_idx],
                                              element_infos->str_size);
     }
@@ -971,6 +1040,16 @@ at_action_rsp_t fRspAnalyze_SOCKETDATA(at_context_t *p_at_ctxt, atcustom_modem_c
 
   END_PARAM_LOOP()
 
+#if (TYPE1SC_RX_READ_AHEAD_SIZE != 0U)
+  if ((p_atp_ctxt->current_atcmd.id == (CMD_ID_t) CMD_AT_SOCKETDATA_RECEIVE) &&
+      (type1sc_shared.socket_rx_to_read_ahead == AT_TRUE) &&
+      (retval == ATACTION_RSP_ERROR))
+  {
+    /* error is reported to the client: the stream of this socket has a gap */
+    ATC_TYPE1SC_readahead_abort(p_modem_ctxt);
+  }
+#endif /* TYPE1SC_RX_READ_AHEAD_SIZE != 0U */
+
   return (retval);
 }
 
@@ -1239,6 +1318,158 @@ void clear_ping_resp_struct(atcustom_modem_context_t *p_modem_ctxt)
   /* p_modem_ctxt->persist.ping_resp_urc.index is unchanged */
 }
 
+#if (TYPE1SC_RX_READ_AHEAD_SIZE != 0U)
+/**
+  * @brief  Read data drained from the modem for the socket requested by the client.
+  * @note   Oldest record of the socket is copied to client buffer. If client buffer is too small,
+  *         remaining data are kept for next read.
+  * @param  p_modem_ctxt Pointer to the structure of Modem context.
+  * @retval at_bool_t Returns AT_TRUE if data have been copied to client buffer.
+  */
+at_bool_t ATC_TYPE1SC_readahead_read(atcustom_modem_context_t *p_modem_ctxt)
+{
+  at_bool_t data_read = AT_FALSE;
+  uint32_t offset = 0U;
+  type1sc_readahead_header_t header;
+  csint_socket_data_buffer_t *p_rcv = &p_modem_ctxt->socket_ctxt.socketReceivedata;
+
+  while ((offset < type1sc_readahead_used) && (data_read == AT_FALSE))
+  {
+    (void) memcpy((void *)&header, (const void *)&type1sc_readahead_buffer[offset],
+                  sizeof(type1sc_readahead_header_t));
+    if ((header.sock_handle == p_rcv->socket_handle) && (p_rcv->p_buffer_addr_rcv != NULL))
+    {
+      uint32_t size = (header.size > p_rcv->max_buffer_size) ? p_rcv->max_buffer_size : header.size;
+      (void) memcpy((void *)p_rcv->p_buffer_addr_rcv,
+                    (const void *)&type1sc_readahead_buffer[offset + sizeof(type1sc_readahead_header_t)],
+                    (size_t) size);
+      p_rcv->buffer_size = size;
+      p_rcv->remote_port = header.remote_port;
+      p_rcv->ip_addr_type = header.ip_addr_type;
+      (void) memcpy((void *)&p_rcv->ip_addr_value[0], (const void *)&header.ip_addr_value[0],
+                    (size_t) MAX_IP_ADDR_SIZE);
+      data_read = AT_TRUE;
+      PRINT_DBG("read-ahead: %ld bytes served to socket handle %ld", size, header.sock_handle)
+
+      if (size < header.size)
+      {
+        /* keep remaining data in this record */
+        header.size -= size;
+        (void) memcpy((void *)&type1sc_readahead_buffer[offset], (const void *)&header,
+                      sizeof(type1sc_readahead_header_t));
+        readahead_remove_data(offset + sizeof(type1sc_readahead_header_t), size);
+      }
+      else
+      {
+        /* record fully read */
+        readahead_remove_data(offset, (uint32_t)sizeof(type1sc_readahead_header_t) + header.size);
+      }
+    }
+    else
+    {
+      /* record for another socket */
+      offset += (uint32_t)sizeof(type1sc_readahead_header_t) + header.size;
+    }
+  }
+
+  return (data_read);
+}
+
+/**
+  * @brief  Get the maximum data size that can be stored in a new read-ahead record.
+  * @retval uint32_t Free size (0 if buffer is full).
+  */
+uint32_t ATC_TYPE1SC_readahead_free_size(void)
+{
+  uint32_t free_size = 0U;
+
+  if ((type1sc_readahead_used + sizeof(type1sc_readahead_header_t)) < TYPE1SC_RX_READ_AHEAD_SIZE)
+  {
+    free_size = TYPE1SC_RX_READ_AHEAD_SIZE - type1sc_readahead_used - (uint32_t)sizeof(type1sc_readahead_header_t);
+  }
+
+  return (free_size);
+}
+
+/**
+  * @brief  Prepare or commit a read-ahead record for the socket requested by the client.
+  * @note   To call before sending a drain request (pending record is empty) and after its response
+  *         (pending record is stored if data have been received).
+  * @param  p_modem_ctxt Pointer to the structure of Modem context.
+  * @retval uint32_t Size of data stored.
+  */
+uint32_t ATC_TYPE1SC_readahead_commit(atcustom_modem_context_t *p_modem_ctxt)
+{
+  uint32_t stored_size = type1sc_readahead_pending.size;
+
+  if (stored_size != 0U)
+  {
+    (void) memcpy((void *)&type1sc_readahead_buffer[type1sc_readahead_used],
+                  (const void *)&type1sc_readahead_pending,
+                  sizeof(type1sc_readahead_header_t));
+    type1sc_readahead_used += (uint32_t)sizeof(type1sc_readahead_header_t) + type1sc_readahead_pending.size;
+    PRINT_DBG("read-ahead: %ld bytes stored (%ld/%ld used)", type1sc_readahead_pending.size,
+              type1sc_readahead_used, TYPE1SC_RX_READ_AHEAD_SIZE)
+  }
+
+  /* reinit pending record */
+  (void) memset((void *)&type1sc_readahead_pending, 0, sizeof(type1sc_readahead_header_t));
+  type1sc_readahead_pending.sock_handle = p_modem_ctxt->socket_ctxt.socketReceivedata.socket_handle;
+
+  return (stored_size);
+}
+
+/**
+  * @brief  Stop draining after a failed drain request.
+  * @note   Data already drained for this socket are discarded too, so that the client never reads data
+  *         following a gap in the stream. The error is reported to the client by the receive request.
+  * @param  p_modem_ctxt Pointer to the structure of Modem context.
+  * @retval none
+  */
+void ATC_TYPE1SC_readahead_abort(atcustom_modem_context_t *p_modem_ctxt)
+{
+  socket_handle_t sockHandle = p_modem_ctxt->socket_ctxt.socketReceivedata.socket_handle;
+
+  PRINT_ERR("drain failed: read-ahead data of socket %ld dropped", sockHandle)
+  type1sc_readahead_pending.size = 0U;
+  type1sc_shared.socket_rx_more_data = 0U;
+  type1sc_shared.socket_rx_to_read_ahead = AT_FALSE;
+  ATC_TYPE1SC_readahead_flush(sockHandle);
+}
+
+/**
+  * @brief  Discard data drained from the modem and not yet read.
+  * @param  sockHandle Socket handle (CS_INVALID_SOCKET_HANDLE to discard data of all sockets).
+  * @retval none
+  */
+void ATC_TYPE1SC_readahead_flush(socket_handle_t sockHandle)
+{
+  uint32_t offset = 0U;
+  type1sc_readahead_header_t header;
+
+  if (sockHandle == CS_INVALID_SOCKET_HANDLE)
+  {
+    type1sc_readahead_used = 0U;
+  }
+  else
+  {
+    while (offset < type1sc_readahead_used)
+    {
+      (void) memcpy((void *)&header, (const void *)&type1sc_readahead_buffer[offset],
+                    sizeof(type1sc_readahead_header_t));
+      if (header.sock_handle == sockHandle)
+      {
+        readahead_remove_data(offset, (uint32_t)sizeof(type1sc_readahead_header_t) + header.size);
+      }
+      else
+      {
+        offset += (uint32_t)sizeof(type1sc_readahead_header_t) + header.size;
+      }
+    }
+  }
+}
+#endif /* TYPE1SC_RX_READ_AHEAD_SIZE != 0U */
+
 /**
   * @}
   */
@@ -1348,6 +1579,27 @@ static at_status_t convertHEXToChar(uint8_t msd, uint8_t lsd, uint8_t *p_conv)
   }
   return (retval);
 }
+
+#if (TYPE1SC_RX_READ_AHEAD_SIZE != 0U)
+/**
+  * @brief  Remove bytes from the read-ahead buffer and compact it.
+  * @param  record_offset Offset of first byte to remove.
+  * @param  size_to_remove Number of bytes to remove.
+  * @retval none
+  */
+static void readahead_remove_data(uint32_t record_offset, uint32_t size_to_remove)
+{
+  uint32_t tail_offset = record_offset + size_to_remove;
+
+  if (tail_offset < type1sc_readahead_used)
+  {
+    (void) memmove((void *)&type1sc_readahead_buffer[record_offset],
+                   (const void *)&type1sc_readahead_buffer[tail_offset],
+                   (size_t)(type1sc_readahead_used - tail_offset));
+  }
+  type1sc_readahead_used -= size_to_remove;
+}
+#endif /* TYPE1SC_RX_READ_AHEAD_SIZE != 0U */
 /**
   * @}
   */
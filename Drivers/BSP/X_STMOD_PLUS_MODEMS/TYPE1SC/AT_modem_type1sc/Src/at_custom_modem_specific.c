@@ -123,6 +123,11 @@ type1sc_shared_variables_t type1sc_shared =
   .modem_bootev_received = false,
   .notifyev_mode = 0U,
   .modem_sim_same_as_selected = true,
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (TYPE1SC_RX_READ_AHEAD_SIZE != 0U)
+  .socket_rx_more_data = 0U,
+  .socket_rx_drain_size = 0U,
+  .socket_rx_to_read_ahead = AT_FALSE,
+#endif /* (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (TYPE1SC_RX_READ_AHEAD_SIZE != 0U) */
 #if (ENABLE_T1SC_LOW_POWER_MODE != 0U)
   .host_lp_state  = HOST_LP_STATE_IDLE,
 #endif /* (ENABLE_T1SC_LOW_POWER_MODE != 0U) */
@@ -1116,6 +1121,12 @@ void ATC_TYPE1SC_reset_variables(void)
   /* Set default values of TYPE1SC specific variables after SWITCH ON or RESET */
   type1sc_shared.modem_waiting_for_bootev = false;
   type1sc_shared.modem_bootev_received = false;
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (TYPE1SC_RX_READ_AHEAD_SIZE != 0U)
+  /* data drained before the reset are lost */
+  type1sc_shared.socket_rx_more_data = 0U;
+  type1sc_shared.socket_rx_to_read_ahead = AT_FALSE;
+  ATC_TYPE1SC_readahead_flush(CS_INVALID_SOCKET_HANDLE);
+#endif /* (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM) && (TYPE1SC_RX_READ_AHEAD_SIZE != 0U) */
 
   /* other values */
 #if (ENABLE_T1SC_LOW_POWER_MODE != 0U)
@@ -153,6 +153,7 @@ typedef uint16_t at_msg_t;
 typedef int16_t at_handle_t;
 typedef uint8_t  at_buf_t;
 typedef void (* urc_callback_t)(at_buf_t *p_rsp_buf);
+typedef void (* data_stream_callback_t)(void);
 
 typedef uint16_t at_hw_event_t;
 #define HWEVT_UNKNOWN            ((at_hw_event_t) 0U)  /* unknown HW event */
@@ -171,6 +172,12 @@ at_status_t  AT_sendcmd(at_handle_t athandle, at_msg_t msg_in_id, at_buf_t *p_cm
 at_status_t  AT_open_channel(at_handle_t athandle);
 at_status_t  AT_close_channel(at_handle_t athandle);
 void         AT_internalEvent(sysctrl_device_type_t deviceType);
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+at_status_t  AT_open_data_channel(at_handle_t athandle, data_stream_callback_t data_callback);
+at_bool_t    AT_is_data_mode(at_handle_t athandle);
+at_status_t  AT_send_data(at_handle_t athandle, const uint8_t *p_buf, uint16_t length);
+int32_t      AT_receive_data(at_handle_t athandle, uint8_t *p_buf, uint16_t max_length);
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
 at_status_t  atcore_task_start(osPriority taskPrio, uint16_t stackSize);
 
 /**
@@ -18,6 +18,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include <string.h>
+#include <stdint.h>
 #include "ipc_common.h"
 #include "at_core.h"
 #include "at_parser.h"
@@ -71,6 +72,7 @@
 #define MSG_IPC_RECEIVED_SIZE (uint32_t) ((uint16_t) 128U)
 #define SIG_IPC_MSG                      (1U) /* signals definition for IPC message queue */
 #define SIG_INTERNAL_EVENT_MODEM         (2U) /* signals definition for internal event from the cellular modem */
+#define SIG_DATA_STREAM                  (3U) /* signals definition for data received on the data channel */
 /**
   * @}
   */
@@ -90,6 +92,14 @@ static osSemaphoreId s_WaitAnswer_SemaphoreId = NULL;
 /* this queue is used by IPC to inform that messages are ready to be retrieved */
 static osMessageQId q_msg_IPC_received_Id;
 
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+/* IPC stream channel selected when an online socket switches the modem to DATA mode */
+static IPC_Handle_t           ipcDataHandle;
+static at_bool_t              data_channel_opened = AT_FALSE;
+static data_stream_callback_t register_data_stream_callback = NULL;
+static __IO uint8_t           DataStreamNotified = 0U; /* data received already signalled, not read yet */
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
+
 /* Mutex used to avoid crossing cases when preparing/parsing AT commands/responses/URC */
 #if (USE_PARSING_MUTEX == 1)
 static osMutexId ATCore_ParsingMutexHandle;
@@ -112,6 +122,10 @@ static at_action_rsp_t process_answer(at_action_send_t action_send, uint32_t at_
 static at_action_rsp_t analyze_action_result(at_action_rsp_t val);
 static void IRQ_DISABLE(void);
 static void IRQ_ENABLE(void);
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+static void dataStreamReceivedCallback(IPC_Handle_t *ipcHandle);
+static void suspend_data_channel(at_buf_t *p_cmd_in_buf, at_buf_t *p_rsp_buf);
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
 /**
   * @}
   */
@@ -402,6 +416,19 @@ at_status_t AT_sendcmd(at_handle_t athandle, at_msg_t msg_in_id, at_buf_t *p_cmd
         TRACE_DBG("<<< restore IPC COMMAND channel >>>")
         (void) IPC_select(at_context.ipc_handle);
       }
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+      else if (data_channel_opened == AT_TRUE)
+      {
+        /* DATA mode of an online socket: escape to COMMAND mode before to process this command,
+         * the socket stays open in the modem and DATA mode is resumed on next socket transfer
+         */
+        suspend_data_channel(p_cmd_in_buf, p_rsp_buf);
+      }
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
+      else
+      {
+        /* nothing to do */
+      }
     }
     /* check if trying to suspend DATA while in command mode */
     else if (msg_in_id == (at_msg_t) SID_CS_DATA_SUSPEND)
@@ -464,6 +491,140 @@ void AT_internalEvent(sysctrl_device_type_t deviceType)
   }
 }
 
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+/**
+  * @brief  Open the data channel used by online sockets.
+  * @note   This IPC stream channel is registered as the other channel of the AT channel:
+  *         it becomes the current channel each time the modem switches to DATA mode.
+  * @param  athandle Handle of the AT context.
+  * @param  data_callback Client callback called (from ATCore task) when data are received in DATA mode.
+  * @retval at_status_t
+  */
+at_status_t AT_open_data_channel(at_handle_t athandle, data_stream_callback_t data_callback)
+{
+  at_status_t retval;
+
+  if (athandle == AT_HANDLE_INVALID)
+  {
+    TRACE_ERR("IPC invalid handle")
+    retval = ATSTATUS_ERROR;
+  }
+  else if (data_channel_opened == AT_TRUE)
+  {
+    /* channel already opened, only update the callback */
+    register_data_stream_callback = data_callback;
+    retval = ATSTATUS_OK;
+  }
+  else
+  {
+    register_data_stream_callback = data_callback;
+    DataStreamNotified = 0U;
+
+    /* the send confirmation is shared with the AT channel (only one channel is active at a time) */
+    if (IPC_open(&ipcDataHandle,
+                 at_context.ipc_device,
+                 IPC_MODE_UART_STREAM,
+                 dataStreamReceivedCallback,
+                 msgSentCallback,
+                 NULL,
+                 NULL) == IPC_OK)
+    {
+      data_channel_opened = AT_TRUE;
+      retval = ATSTATUS_OK;
+    }
+    else
+    {
+      TRACE_ERR("IPC data channel open error")
+      retval = ATSTATUS_ERROR;
+    }
+  }
+
+  return (retval);
+}
+
+/**
+  * @brief  Check if the modem is in DATA mode on the data channel.
+  * @param  athandle Handle of the AT context.
+  * @retval at_bool_t
+  */
+at_bool_t AT_is_data_mode(at_handle_t athandle)
+{
+  at_bool_t retval = AT_FALSE;
+
+  if ((athandle != AT_HANDLE_INVALID) && (data_channel_opened == AT_TRUE))
+  {
+    retval = at_context.in_data_mode;
+  }
+
+  return (retval);
+}
+
+/**
+  * @brief  Send raw data on the data channel.
+  * @note   Only possible while the modem is in DATA mode.
+  * @param  athandle Handle of the AT context.
+  * @param  p_buf Pointer to the data to send.
+  * @param  length Length of the data.
+  * @retval at_status_t
+  */
+at_status_t AT_send_data(at_handle_t athandle, const uint8_t *p_buf, uint16_t length)
+{
+  at_status_t retval = ATSTATUS_ERROR;
+
+  if (AT_is_data_mode(athandle) == AT_TRUE)
+  {
+    at_context.dataSent = AT_FALSE;
+    if (IPC_send(&ipcDataHandle, (uint8_t *)p_buf, length) == IPC_ERROR)
+    {
+      TRACE_ERR("IPC data send error")
+    }
+    else
+    {
+      (void) rtosalSemaphoreAcquire(at_context.s_SendConfirm_SemaphoreId, 5000U);
+      if (at_context.dataSent == AT_TRUE)
+      {
+        retval = ATSTATUS_OK;
+      }
+    }
+  }
+
+  return (retval);
+}
+
+/**
+  * @brief  Read raw data received on the data channel.
+  * @note   Data received before an escape to COMMAND mode remain readable.
+  *         Never blocking: the data callback signals when new data are received.
+  * @param  athandle Handle of the AT context.
+  * @param  p_buf Pointer to the buffer to fill.
+  * @param  max_length Size of the buffer.
+  * @retval int32_t number of bytes read or -1 on error.
+  */
+int32_t AT_receive_data(at_handle_t athandle, uint8_t *p_buf, uint16_t max_length)
+{
+  int32_t retval = -1;
+
+  if ((athandle != AT_HANDLE_INVALID) && (data_channel_opened == AT_TRUE) && (max_length > 0U))
+  {
+    int16_t length = (max_length > (uint16_t)INT16_MAX) ? INT16_MAX : (int16_t)max_length;
+
+    IRQ_DISABLE();
+    if (IPC_streamReceive(&ipcDataHandle, p_buf, &length) == IPC_OK)
+    {
+      retval = (int32_t)length;
+    }
+    /* stream empty: next received byte has to be signalled again */
+    if (ipcDataHandle.RxBuffer.available_char == 0U)
+    {
+      DataStreamNotified = 0U;
+    }
+    IRQ_ENABLE();
+  }
+
+  return (retval);
+}
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
+
 /**
   * @brief  Start AT task.
   * @param  taskPrio Task priority.
@@ -551,6 +712,25 @@ static void msgReceivedCallback(IPC_Handle_t *ipcHandle)
   }
 }
 
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+/**
+  * @brief  Callback used to inform that data have been received on the data channel.
+  * @note   Only the first byte received after the stream has been emptied is signalled to ATCore task.
+  * @param  ipcHandle Pointer to IPC context.
+  * @retval none.
+  */
+static void dataStreamReceivedCallback(IPC_Handle_t *ipcHandle)
+{
+  UNUSED(ipcHandle);
+  /* Warning ! this function is called under IT: do not add trace */
+  if (DataStreamNotified == 0U)
+  {
+    DataStreamNotified = 1U;
+    (void) rtosalMessageQueuePut(q_msg_IPC_received_Id, (uint32_t)SIG_DATA_STREAM, (uint32_t)0U);
+  }
+}
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
+
 /**
   * @brief  Callback used to inform that an AT message has been sent.
   * @param  ipcHandle Pointer to IPC context.
@@ -873,6 +1053,32 @@ static at_status_t waitFromIPC(uint32_t tickstart, uint32_t cmdTimeout, IPC_RxMe
   return (retval);
 }
 
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+/**
+  * @brief  Escape from DATA mode of the data channel before to process another command.
+  * @note   Sends the modem escape sequence (SID_CS_DATA_SUSPEND, guard time managed by the modem driver).
+  *         On failure, COMMAND mode is forced as for an explicit DATA suspend request.
+  * @param  p_cmd_in_buf Pointer to the buffer of the command to process after the escape (not used by the escape).
+  * @param  p_rsp_buf Pointer to the response buffer.
+  * @retval none.
+  */
+static void suspend_data_channel(at_buf_t *p_cmd_in_buf, at_buf_t *p_rsp_buf)
+{
+  TRACE_INFO("<<< leave DATA mode of the data channel >>>")
+  (void) IPC_select(at_context.ipc_handle);
+
+  ATParser_process_request(&at_context, (at_msg_t) SID_CS_DATA_SUSPEND, p_cmd_in_buf);
+  if (process_AT_transaction((at_msg_t) SID_CS_DATA_SUSPEND, p_rsp_buf) != ATSTATUS_OK)
+  {
+    TRACE_ERR("escape from DATA mode failed, force to return to COMMAND mode")
+    ATParser_abort_request(&at_context);
+  }
+  /* modem is back in COMMAND mode or considered as is: process the command anyway */
+  at_context.in_data_mode = AT_FALSE;
+  (void) memset((void *)p_rsp_buf, 0, ATCMD_MAX_BUF_SIZE);
+}
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
+
 /**
   * @brief  Analyze action bitmap.
   * @param  val Action bitmap.
@@ -1067,6 +1273,16 @@ static void ATCoreTaskBody(void *argument)
           } while (retUrc == ATSTATUS_OK_PENDING_URC);
         }
       }
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+      else if (msg == (SIG_DATA_STREAM))
+      {
+        /* data received on the data channel: notify the client out of interrupt context */
+        if (register_data_stream_callback != NULL)
+        {
+          (* register_data_stream_callback)();
+        }
+      }
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
       else
       {
         /* should not happen */
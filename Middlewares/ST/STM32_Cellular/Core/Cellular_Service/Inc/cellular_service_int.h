@@ -226,6 +226,9 @@ typedef struct
   CS_CHAR_t           ip_addr_value[MAX_IP_ADDR_SIZE]; /* remote IP address */
   uint16_t            remote_port;
 
+  /* payload exchange: command mode (default) or online mode, set before socket connect */
+  CS_ConnectionMode_t trp_connect_mode;
+
 #if defined(CSAPI_OPTIONAL_FUNCTIONS)
   CS_SocketOptionName_t config;
 
@@ -235,7 +238,6 @@ typedef struct
   uint16_t trp_conn_setup_timeout; /* 10 to 1200 hundreds of ms, 0 means infinite,
                                     * default = DEFAULT_TRP_CONN_SETUP_TIMEOUT */
   uint16_t trp_transfer_timeout; /* 0 to 255 ms, 0 means infinite, default = DEFAULT_TRP_TRANSFER_TIMEOUT */
-  CS_ConnectionMode_t trp_connect_mode;
   uint16_t trp_suspend_timeout; /* 0 to 2000 ms , 0 means infinite, default = DEFAULT_TRP_SUSPEND_TIMEOUT */
   uint16_t trp_rx_timeout; /* 0 to 255 ms, 0 means infinite, default = DEFAULT_TRP_RX_TIMEOUT */
 #endif /*defined(CSAPI_OPTIONAL_FUNCTIONS) */
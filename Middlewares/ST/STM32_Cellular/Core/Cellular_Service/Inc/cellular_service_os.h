@@ -78,6 +78,16 @@ CS_Status_t osCDS_socket_set_callbacks(socket_handle_t sockHandle,
                                        cellular_socket_data_sent_callback_t data_sent_cb,
                                        cellular_socket_closed_callback_t remote_close_cb);
 
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+/**
+  * @brief  Select how the payload of a created socket is exchanged with the modem.
+  * @note   Call CDS_socket_set_connect_mode with mutex access protection
+  * @param  same parameters as the CDS_socket_set_connect_mode function
+  * @retval CS_Status_t
+  */
+CS_Status_t osCDS_socket_set_connect_mode(socket_handle_t sockHandle, CS_ConnectionMode_t mode);
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
+
 #if defined(CSAPI_OPTIONAL_FUNCTIONS)
 /**
   * @brief  Define configurable options for a created socket.
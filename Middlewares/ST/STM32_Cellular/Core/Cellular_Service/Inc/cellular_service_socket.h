@@ -72,8 +72,9 @@ typedef enum
 typedef uint16_t CS_ConnectionMode_t; /* uint16_t is used to keep API consistent */
 #define CS_CM_COMMAND_MODE              (CS_ConnectionMode_t)(0x0U) /* remains in command line after each
                                                                      * packet transmission (tx or rx) - default */
-#define CS_CM_ONLINE_MODE               (CS_ConnectionMode_t)(0x1U) /* NOT SUPPORTED - remains in online mode until
-                                                                     * transfer over socket is closed */
+#define CS_CM_ONLINE_MODE               (CS_ConnectionMode_t)(0x1U) /* remains in online mode until transfer over
+                                                                     * socket is closed or a command has to be
+                                                                     * sent (USE_SOCKETS_ONLINE_MODE, TCP only) */
 #define CS_CM_ONLINE_AUTOMATIC_SUSPEND  (CS_ConnectionMode_t)(0x2U) /* NOT SUPPORTED - remains in online mode until
                                                                      * a suspend timeout expires */
 #if defined(CSAPI_OPTIONAL_FUNCTIONS)
@@ -166,6 +167,9 @@ CS_Status_t CDS_socket_set_callbacks(socket_handle_t sockHandle,
                                      cellular_socket_data_ready_callback_t data_ready_cb,
                                      cellular_socket_data_sent_callback_t data_sent_cb,
                                      cellular_socket_closed_callback_t remote_close_cb);
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+CS_Status_t CDS_socket_set_connect_mode(socket_handle_t sockHandle, CS_ConnectionMode_t mode);
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
 #if defined(CSAPI_OPTIONAL_FUNCTIONS)
 CS_Status_t CDS_socket_set_option(socket_handle_t sockHandle,
                                   CS_SocketOptionLevel_t opt_level,
@@ -150,6 +150,7 @@ void csint_socket_init(socket_handle_t index)
   cs_ctxt_sockets_info[index].protocol = CS_TCP_PROTOCOL;
   cs_ctxt_sockets_info[index].local_port = 0U;
   cs_ctxt_sockets_info[index].conf_id = CS_PDN_NOT_DEFINED;
+  cs_ctxt_sockets_info[index].trp_connect_mode = CS_CM_COMMAND_MODE;
 
 #if defined(CSAPI_OPTIONAL_FUNCTIONS)
   cs_ctxt_sockets_info[index].config = CS_SON_NO_OPTION;
@@ -159,7 +160,6 @@ void csint_socket_init(socket_handle_t index)
   cs_ctxt_sockets_info[index].trp_max_timeout = DEFAULT_TRP_MAX_TIMEOUT;
   cs_ctxt_sockets_info[index].trp_conn_setup_timeout = DEFAULT_TRP_CONN_SETUP_TIMEOUT;
   cs_ctxt_sockets_info[index].trp_transfer_timeout = DEFAULT_TRP_TRANSFER_TIMEOUT;
-  cs_ctxt_sockets_info[index].trp_connect_mode = CS_CM_COMMAND_MODE;
   cs_ctxt_sockets_info[index].trp_suspend_timeout = DEFAULT_TRP_SUSPEND_TIMEOUT;
   cs_ctxt_sockets_info[index].trp_rx_timeout = DEFAULT_TRP_RX_TIMEOUT;
 #endif /* defined(CSAPI_OPTIONAL_FUNCTIONS) */
@@ -66,6 +66,27 @@
   * @}
   */
 
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+/** @defgroup CELLULAR_SERVICE_SOCKET_API_Private_Variables CELLULAR_SERVICE_SOCKET API Private Variables
+  * @{
+  */
+/* socket using the modem DATA mode (only one online socket at a time) */
+static socket_handle_t cs_online_socket = CS_INVALID_SOCKET_HANDLE;
+/**
+  * @}
+  */
+
+/** @defgroup CELLULAR_SERVICE_SOCKET_API_Private_Functions_Prototypes CELLULAR_SERVICE_SOCKET API Private Prototypes
+  * @{
+  */
+static void socket_online_data_received(void);
+static void socket_online_flush(void);
+static CS_Status_t socket_online_resume(void);
+/**
+  * @}
+  */
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
+
 /** @defgroup CELLULAR_SERVICE_SOCKET_API_Exported_Functions CELLULAR_SERVICE_SOCKET API Exported Functions
   * @{
   */
@@ -196,6 +217,48 @@ CS_Status_t CDS_socket_set_callbacks(socket_handle_t sockHandle,
   return (retval);
 }
 
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+/**
+  * @brief  Select how the payload of a created socket is exchanged with the modem.
+  * @note   This function has to be called before to connect the socket.
+  *         In CS_CM_ONLINE_MODE, the modem is switched to DATA mode at socket connection and the payload is
+  *         exchanged as a raw byte stream. DATA mode is left (escape sequence) each time another command has
+  *         to be sent and resumed on next transfer over the socket.
+  *         If the modem (or its driver) does not support it, the socket falls back to command mode.
+  * @param  sockHandle Handle of the socket
+  * @param  mode CS_CM_COMMAND_MODE or CS_CM_ONLINE_MODE (TCP only).
+  * @retval CS_Status_t
+  */
+CS_Status_t CDS_socket_set_connect_mode(socket_handle_t sockHandle, CS_ConnectionMode_t mode)
+{
+  CS_Status_t retval = CS_ERROR;
+
+  /* check that socket has been allocated and is not connected yet */
+  if (cs_ctxt_sockets_info[sockHandle].state != SOCKETSTATE_CREATED)
+  {
+    PRINT_ERR("<Cellular_Service> invalid socket state %d for handle %ld (connect mode)",
+              cs_ctxt_sockets_info[sockHandle].state,
+              sockHandle)
+  }
+  else if (mode == CS_CM_COMMAND_MODE)
+  {
+    cs_ctxt_sockets_info[sockHandle].trp_connect_mode = CS_CM_COMMAND_MODE;
+    retval = CS_OK;
+  }
+  else if ((mode == CS_CM_ONLINE_MODE) && (cs_ctxt_sockets_info[sockHandle].protocol == CS_TCP_PROTOCOL))
+  {
+    cs_ctxt_sockets_info[sockHandle].trp_connect_mode = CS_CM_ONLINE_MODE;
+    retval = CS_OK;
+  }
+  else
+  {
+    PRINT_ERR("<Cellular_Service> Connection mode not supported")
+  }
+
+  return (retval);
+}
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
+
 #if defined(CSAPI_OPTIONAL_FUNCTIONS)
 /**
   * @brief  Define configurable options for a created socket.
@@ -264,11 +327,55 @@ CS_Status_t CDS_socket_connect(socket_handle_t sockHandle,
     * no need to test sockHandle validity, it has been tested in csint_socket_configure_remote()
     */
     csint_socket_infos_t *socket_infos = &cs_ctxt_sockets_info[sockHandle];
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+    if (socket_infos->trp_connect_mode == CS_CM_ONLINE_MODE)
+    {
+      /* only one socket can use DATA mode */
+      if ((cs_online_socket != CS_INVALID_SOCKET_HANDLE) ||
+          (AT_open_data_channel(get_Adapter_Handle(), socket_online_data_received) != ATSTATUS_OK))
+      {
+        PRINT_INFO("<Cellular_Service> online mode not available, socket %ld uses command mode", sockHandle)
+        socket_infos->trp_connect_mode = CS_CM_COMMAND_MODE;
+      }
+      else
+      {
+        /* drop data left by a previous online socket */
+        socket_online_flush();
+      }
+    }
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
     if (DATAPACK_writePtr(getCmdBufPtr(),
                           (uint16_t) CSMT_SOCKET_INFO,
                           (void *)socket_infos) == DATAPACK_OK)
     {
       err = AT_sendcmd(get_Adapter_Handle(), (at_msg_t) SID_CS_DIAL_COMMAND, getCmdBufPtr(), getRspBufPtr());
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+      if (socket_infos->trp_connect_mode == CS_CM_ONLINE_MODE)
+      {
+        if (err != ATSTATUS_OK)
+        {
+          /* fallback: modem refused to open the socket in online mode, retry in command mode */
+          PRINT_INFO("<Cellular_Service> online mode refused, socket %ld retried in command mode", sockHandle)
+          socket_infos->trp_connect_mode = CS_CM_COMMAND_MODE;
+          if (DATAPACK_writePtr(getCmdBufPtr(),
+                                (uint16_t) CSMT_SOCKET_INFO,
+                                (void *)socket_infos) == DATAPACK_OK)
+          {
+            err = AT_sendcmd(get_Adapter_Handle(), (at_msg_t) SID_CS_DIAL_COMMAND, getCmdBufPtr(), getRspBufPtr());
+          }
+        }
+        else if (AT_is_data_mode(get_Adapter_Handle()) == AT_TRUE)
+        {
+          PRINT_INFO("<Cellular_Service> socket %ld connected in online mode", sockHandle)
+          cs_online_socket = sockHandle;
+        }
+        else
+        {
+          /* modem driver without online mode support: socket opened in command mode */
+          socket_infos->trp_connect_mode = CS_CM_COMMAND_MODE;
+        }
+      }
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
       if (err == ATSTATUS_OK)
       {
         /* update socket state */
@@ -319,6 +426,19 @@ CS_Status_t CDS_socket_send(socket_handle_t sockHandle,
               cs_ctxt_sockets_info[sockHandle].state,
               sockHandle)
   }
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+  else if (sockHandle == cs_online_socket)
+  {
+    /* online socket: raw data on the data channel */
+    if (socket_online_resume() == CS_OK)
+    {
+      if (AT_send_data(get_Adapter_Handle(), (const uint8_t *)p_buf, (uint16_t)length) == ATSTATUS_OK)
+      {
+        retval = CS_OK;
+      }
+    }
+  }
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
   else
   {
     csint_socket_data_buffer_t send_data_struct;
@@ -481,6 +601,30 @@ int32_t CDS_socket_receive(socket_handle_t sockHandle,
               cs_ctxt_sockets_info[sockHandle].state,
               sockHandle)
   }
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+  else if (sockHandle == cs_online_socket)
+  {
+    /* online socket: read the data channel, data received before an escape are still there */
+    int32_t rcv_size = AT_receive_data(get_Adapter_Handle(), (uint8_t *)p_buf, (uint16_t)max_buf_length);
+    if ((rcv_size == 0) && (AT_is_data_mode(get_Adapter_Handle()) == AT_FALSE))
+    {
+      /* nothing buffered: resume DATA mode to get data kept by the modem, they will be signalled */
+      if (socket_online_resume() == CS_OK)
+      {
+        rcv_size = AT_receive_data(get_Adapter_Handle(), (uint8_t *)p_buf, (uint16_t)max_buf_length);
+      }
+      else
+      {
+        rcv_size = -1;
+      }
+    }
+    if (rcv_size >= 0)
+    {
+      bytes_received = (uint32_t)rcv_size;
+      status = CS_OK;
+    }
+  }
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
   else
   {
     csint_socket_data_buffer_t receive_data_struct = {0};
@@ -657,9 +801,16 @@ CS_Status_t CDS_socket_close(socket_handle_t sockHandle, uint8_t force)
                           (void *)socket_infos) == DATAPACK_OK)
     {
       at_status_t err;
+      /* an online socket leaves DATA mode (escape sequence) before the close command */
       err = AT_sendcmd(get_Adapter_Handle(), (at_msg_t) SID_CS_SOCKET_CLOSE, getCmdBufPtr(), getRspBufPtr());
       if (err == ATSTATUS_OK)
       {
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+        if (sockHandle == cs_online_socket)
+        {
+          cs_online_socket = CS_INVALID_SOCKET_HANDLE;
+        }
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
         /* deallocate socket handle and reinit socket parameters */
         csint_socket_deallocateHandle(sockHandle);
         retval = CS_OK;
@@ -680,6 +831,12 @@ CS_Status_t CDS_socket_close(socket_handle_t sockHandle, uint8_t force)
   else if (cs_ctxt_sockets_info[sockHandle].state == SOCKETSTATE_ALLOC_BUT_INVALID)
   {
     PRINT_INFO("<Cellular_Service> invalid socket state (after modem reboot) ")
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+    if (sockHandle == cs_online_socket)
+    {
+      cs_online_socket = CS_INVALID_SOCKET_HANDLE;
+    }
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
     /* deallocate socket handle and reinit socket parameters */
     csint_socket_deallocateHandle(sockHandle);
     retval = CS_OK;
@@ -944,6 +1101,82 @@ CS_Status_t CDS_socket_listen(socket_handle_t sockHandle)
   * @}
   */
 
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+/** @defgroup CELLULAR_SERVICE_SOCKET_API_Private_Functions CELLULAR_SERVICE_SOCKET API Private Functions
+  * @{
+  */
+
+/**
+  * @brief  Data received on the data channel (called from ATCore task).
+  * @param  none
+  * @retval none
+  */
+static void socket_online_data_received(void)
+{
+  socket_handle_t sockHandle = cs_online_socket;
+
+  if (sockHandle != CS_INVALID_SOCKET_HANDLE)
+  {
+    /* inform client that data are pending */
+    if (cs_ctxt_sockets_info[sockHandle].socket_data_ready_callback != NULL)
+    {
+      (* cs_ctxt_sockets_info[sockHandle].socket_data_ready_callback)(sockHandle);
+    }
+  }
+}
+
+/**
+  * @brief  Drop data left in the data channel.
+  * @param  none
+  * @retval none
+  */
+static void socket_online_flush(void)
+{
+  uint8_t dummy_buf[32];
+
+  while (AT_receive_data(get_Adapter_Handle(), dummy_buf, (uint16_t)sizeof(dummy_buf)) > 0)
+  {
+    /* data dropped */
+  }
+}
+
+/**
+  * @brief  Switch the modem back to DATA mode for the online socket if it has been left.
+  * @param  none
+  * @retval CS_Status_t
+  */
+static CS_Status_t socket_online_resume(void)
+{
+  CS_Status_t retval = CS_OK;
+
+  if (AT_is_data_mode(get_Adapter_Handle()) == AT_FALSE)
+  {
+    retval = CS_ERROR;
+    if (DATAPACK_writeStruct(getCmdBufPtr(),
+                             (uint16_t) CSMT_NONE,
+                             (uint16_t) 0U,
+                             NULL) == DATAPACK_OK)
+    {
+      if ((AT_sendcmd(get_Adapter_Handle(), (at_msg_t) SID_CS_DATA_RESUME, getCmdBufPtr(), getRspBufPtr())
+           == ATSTATUS_OK) && (AT_is_data_mode(get_Adapter_Handle()) == AT_TRUE))
+      {
+        retval = CS_OK;
+      }
+      else
+      {
+        PRINT_ERR("<Cellular_Service> online socket %ld: DATA mode can not be resumed", cs_online_socket)
+      }
+    }
+  }
+
+  return (retval);
+}
+
+/**
+  * @}
+  */
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
+
 /**
   * @}
   */
@@ -260,7 +260,9 @@ void IPC_RXFIFO_stream_init(IPC_Handle_t *const hipc)
 /**
   * @brief  Write a char in the IPC RX FIFO in stream mode.
   * @note   This function is called by UART callback when a character is received on UART.
-  * @note   It is used in IPC stream IPC mode (LwIP).
+  * @note   It is used in IPC stream IPC mode (LwIP, online modem sockets).
+  * @note   When the buffer is nearly full, RX interrupt is not rearmed (IPC paused) until the client reads
+  *         the stream: with hardware flow control, the modem is then held instead of overwriting unread data.
   * @param  hipc IPC handle.
   * @param  rxChar character to write.
   * @retval none.
@@ -271,8 +273,18 @@ void IPC_RXFIFO_writeStream(IPC_Handle_t *const hipc, uint8_t rxChar)
   {
     hipc->RxBuffer.data[hipc->RxBuffer.index_write] = rxChar;
 
-    /* rearm RX Interrupt */
-    RXFIFO_rearm_RX_IT(hipc);
+    if ((IPC_RXBUF_STREAM_MAXSIZE - hipc->RxBuffer.available_char) <= IPC_RXBUF_THRESHOLD)
+    {
+      hipc->State = IPC_STATE_PAUSED;
+#if (DBG_IPC_RX_FIFO == 1U)
+      hipc->dbgRxQueue.cpt_RXPause++;
+#endif /* DBG_IPC_RX_FIFO == 1U */
+    }
+    else
+    {
+      /* rearm RX Interrupt */
+      RXFIFO_rearm_RX_IT(hipc);
+    }
 
     hipc->RxBuffer.index_write++;
     hipc->RxBuffer.total_rcv_count++;
@@ -218,19 +218,29 @@ IPC_Status_t IPC_UART_open(IPC_Handle_t *const hipc,
     IPC_RXFIFO_stream_init(hipc);
 #endif /* IPC_USE_STREAM_MODE == 1U */
 
-    /* start RX IT */
-    uart_status = HAL_UART_Receive_IT(hipc->Interface.h_uart, (uint8_t *)IPC_DevicesList[device].RxChar, 1U);
-    if (uart_status != HAL_OK)
+    if (IPC_DevicesList[device].h_current_channel != hipc)
     {
-      PRINT_DBG("HAL_UART_Receive_IT error")
-      retval = IPC_ERROR;
+      /* channel registered as inactive: RX IT is already running for the active channel
+       * and will feed this channel once it is selected
+       */
+      hipc->State = IPC_STATE_ACTIVE;
     }
     else
     {
-      /* if we fall here, retval was equal to IPC_OK after parameters check
-       * no error detected, IPC becomes active
-       */
-      hipc->State = IPC_STATE_ACTIVE;
+      /* start RX IT */
+      uart_status = HAL_UART_Receive_IT(hipc->Interface.h_uart, (uint8_t *)IPC_DevicesList[device].RxChar, 1U);
+      if (uart_status != HAL_OK)
+      {
+        PRINT_DBG("HAL_UART_Receive_IT error")
+        retval = IPC_ERROR;
+      }
+      else
+      {
+        /* if we fall here, retval was equal to IPC_OK after parameters check
+         * no error detected, IPC becomes active
+         */
+        hipc->State = IPC_STATE_ACTIVE;
+      }
     }
   }
   return (retval);
@@ -380,8 +390,25 @@ IPC_Status_t IPC_UART_select(IPC_Handle_t *const hipc)
   PRINT_DBG("IPC select %p", hipc)
   if (hipc != IPC_DevicesList[hipc->Device_ID].h_current_channel)
   {
+    IPC_Handle_t *h_previous_channel = IPC_DevicesList[hipc->Device_ID].h_current_channel;
+
     /* update IPC channel */
     (void) change_ipc_channel(hipc);
+
+#if (IPC_USE_STREAM_MODE == 1U)
+    /* a stream channel paused on a full buffer does not rearm RX IT anymore:
+     * rearm it for the new channel, unread stream data stay available
+     */
+    if ((h_previous_channel != NULL) &&
+        (h_previous_channel->Mode == IPC_MODE_UART_STREAM) &&
+        (h_previous_channel->State == IPC_STATE_PAUSED))
+    {
+      h_previous_channel->State = IPC_STATE_ACTIVE;
+      IPC_UART_rearm_RX_IT(hipc);
+    }
+#else
+    UNUSED(h_previous_channel);
+#endif /* IPC_USE_STREAM_MODE == 1U */
   }
 
   return (IPC_OK);
@@ -539,18 +566,43 @@ IPC_Status_t IPC_UART_streamReceive(IPC_Handle_t *const hipc,  uint8_t *const p_
 
     if (hipc->Mode == IPC_MODE_UART_STREAM)
     {
-      /* receive */
+      /* receive: copy at most two contiguous chunks (before and after the wrap of the circular buffer) */
       while ((hipc->RxBuffer.available_char != 0U) &&
              (rx_size < maximum_buffer_size))
       {
-        p_buffer[rx_size] = hipc->RxBuffer.data[hipc->RxBuffer.index_read];
-        hipc->RxBuffer.index_read++;
+        uint16_t chunk_size = IPC_RXBUF_STREAM_MAXSIZE - hipc->RxBuffer.index_read;
+        if (chunk_size > hipc->RxBuffer.available_char)
+        {
+          chunk_size = hipc->RxBuffer.available_char;
+        }
+        if (chunk_size > (maximum_buffer_size - rx_size))
+        {
+          chunk_size = maximum_buffer_size - rx_size;
+        }
+        (void) memcpy((void *)&p_buffer[rx_size],
+                      (const void *)&hipc->RxBuffer.data[hipc->RxBuffer.index_read],
+                      (size_t)chunk_size);
+        hipc->RxBuffer.index_read += chunk_size;
         if (hipc->RxBuffer.index_read >= IPC_RXBUF_STREAM_MAXSIZE)
         {
           hipc->RxBuffer.index_read = 0;
         }
-        rx_size++;
-        hipc->RxBuffer.available_char--;
+        rx_size += chunk_size;
+        hipc->RxBuffer.available_char -= chunk_size;
+      }
+
+      /* resume reception if it has been paused because the stream buffer was full */
+      if ((hipc->State == IPC_STATE_PAUSED) &&
+          ((IPC_RXBUF_STREAM_MAXSIZE - hipc->RxBuffer.available_char) > IPC_RXBUF_THRESHOLD))
+      {
+        hipc->State = IPC_STATE_ACTIVE;
+        HAL_StatusTypeDef uart_status;
+        uart_status = HAL_UART_Receive_IT(hipc->Interface.h_uart,
+                                          (uint8_t *)IPC_DevicesList[hipc->Device_ID].RxChar, 1U);
+        if (uart_status != HAL_OK)
+        {
+          set_rearm_error();
+        }
       }
 
       /* update buffer size */
@@ -505,7 +505,11 @@ rtosalStatus rtosalTimerStart(osTimerId timer_id, uint32_t millisec)
   rtosalStatus status;
 
 #if (osCMSIS < 0x20000U)
+#if defined RTOSAL_TIMER_START
+  status = RTOSAL_TIMER_START(timer_id, millisec);
+#else
   status = osTimerStart(timer_id, millisec);
+#endif /* defined RTOSAL_TIMER_START */
 #else
   uint32_t ticks = rtosal_convert_ms_to_ticks(millisec);
   status = osTimerStart(timer_id, ticks);
@@ -105,9 +105,12 @@ int32_t com_socket_ip_modem(int32_t family, int32_t type, int32_t protocol);
   *         - COM_SO_SNDTIMEO : OK but value not used because there is already
   *                             a tempo at low level - risk of conflict
   *         - COM_SO_RCVTIMEO : OK
+  *         - COM_SO_TRANSPARENT : OK if USE_SOCKETS_ONLINE_MODE == 1,
+  *                                TCP socket only and before com_connect
   *         - any other value is rejected
   * @param  optval    - pointer to the buffer containing the option value
   * @note   COM_SO_SNDTIMEO and COM_SO_RCVTIMEO : unit is ms
+  *         COM_SO_TRANSPARENT : 0 command mode (default), other value transparent mode (uint32_t)
   * @param  optlen    - size of the buffer containing the option value
   * @retval int32_t   - ok or error value
   */
@@ -124,10 +127,12 @@ int32_t com_setsockopt_ip_modem(int32_t sock, int32_t level, int32_t optname,
   * @param  optname   - option name for which the value is requested
   * @note
   *         - COM_SO_SNDTIMEO, COM_SO_RCVTIMEO, COM_SO_ERROR supported
+  *         - COM_SO_TRANSPARENT supported if USE_SOCKETS_ONLINE_MODE == 1
   *         - any other value is rejected
   * @param  optval    - pointer to the buffer that will contain the option value
   * @note   COM_SO_SNDTIMEO, COM_SO_RCVTIMEO: in ms for timeout (uint32_t)
   *         COM_SO_ERROR : result of last operation (int32_t)
+  *         COM_SO_TRANSPARENT : 1 if transparent mode requested, 0 otherwise (uint32_t)
   * @param  optlen    - size of the buffer that will contain the option value
   * @note   must be sizeof(x32_t)
   * @retval int32_t   - ok or error value
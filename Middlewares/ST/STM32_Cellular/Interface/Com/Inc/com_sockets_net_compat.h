@@ -88,6 +88,7 @@ extern "C" {
 #define COM_SO_SNDTIMEO    0x1005 /*!< Socket Options send timeout - used for (get/set)sockopt() */
 #define COM_SO_RCVTIMEO    0x1006 /*!< Socket Options receive timeout - used for (get/set)sockopt() */
 #define COM_SO_ERROR       0x1007 /*!< Socket Options get error status and clear - used for (get/set)sockopt() */
+#define COM_SO_TRANSPARENT 0x100A /*!< Socket Options transparent (online) access mode - used for (get/set)sockopt() */
 
 /* Flags used with recv. */
 #define COM_MSG_WAIT       0x00    /*!< Blocking     */
@@ -157,6 +158,8 @@ extern "C" {
 #define COM_SO_SNDTIMEO    SO_SNDTIMEO
 #define COM_SO_RCVTIMEO    SO_RCVTIMEO
 #define COM_SO_ERROR       SO_ERROR
+/* Transparent access mode is a modem socket option: unknown value for LwIP, (get/set)sockopt() rejects it */
+#define COM_SO_TRANSPARENT 0x100A
 
 /* Flags used with recv. */
 #define COM_MSG_WAIT       0x00
@@ -102,6 +102,9 @@ typedef struct _socket_desc_t
   com_ip_addr_t         remote_addr; /* remote addr             */
   uint32_t              snd_timeout; /* timeout for send cmd    */
   uint32_t              rcv_timeout; /* timeout for receive cmd */
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+  bool                  transparent; /* transparent mode asked */
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
   osMessageQId          queue;       /* message queue for URC   */
 #if (USE_COM_PING == 1)
   com_ping_rsp_t        *p_ping_rsp; /* pointer on ping rsp     */
@@ -271,6 +274,9 @@ static void com_ip_modem_init_socket_desc(socket_desc_t *p_socket_desc)
   p_socket_desc->rcv_timeout      = RTOSAL_WAIT_FOREVER; /* default value, updated with setsockopt COM_SO_RCVTIMEO */
   p_socket_desc->snd_timeout      = RTOSAL_WAIT_FOREVER; /* default value, updated with setsockopt COM_SO_SNDTIMEO */
   p_socket_desc->error            = COM_SOCKETS_ERR_OK;
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+  p_socket_desc->transparent      = false; /* default value, updated with setsockopt COM_SO_TRANSPARENT */
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
   /* p_socket_desc->p_next is not re-initialized - element is let in the list at its place */
   /* p_socket_desc->queue is not re-initialized  - queue is reused */
 }
@@ -1370,9 +1376,12 @@ int32_t com_socket_ip_modem(int32_t family, int32_t type, int32_t protocol)
   *         - COM_SO_SNDTIMEO : OK but value not used because there is already
   *                             a tempo at low level - risk of conflict
   *         - COM_SO_RCVTIMEO : OK
+  *         - COM_SO_TRANSPARENT : OK if USE_SOCKETS_ONLINE_MODE == 1,
+  *                                TCP socket only and before com_connect
   *         - any other value is rejected
   * @param  optval    - pointer to the buffer containing the option value
   * @note   COM_SO_SNDTIMEO and COM_SO_RCVTIMEO : unit is ms
+  *         COM_SO_TRANSPARENT : 0 command mode (default), other value transparent mode (uint32_t)
   * @param  optlen    - size of the buffer containing the option value
   * @retval int32_t   - ok or error value
   */
@@ -1427,6 +1436,30 @@ int32_t com_setsockopt_ip_modem(int32_t sock, int32_t level, int32_t optname, co
             __NOP(); /* result already set to COM_SOCKETS_ERR_PARAMETER */
             break;
 
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+          /* Transparent access mode */
+          case COM_SO_TRANSPARENT :
+            /* Only possible on a TCP socket not yet connected */
+            if (((uint32_t)optlen == sizeof(uint32_t))
+                && (p_socket_desc->type == (uint8_t)COM_SOCK_STREAM)
+                && (p_socket_desc->state == COM_SOCKET_CREATED))
+            {
+              bool transparent = (*(const uint32_t *)optval != 0U) ? true : false;
+              if (osCDS_socket_set_connect_mode(p_socket_desc->id,
+                                                (transparent == true) ? CS_CM_ONLINE_MODE : CS_CM_COMMAND_MODE)
+                  == CS_OK)
+              {
+                p_socket_desc->transparent = transparent;
+                result = COM_SOCKETS_ERR_OK;
+              }
+              else
+              {
+                result = COM_SOCKETS_ERR_GENERAL;
+              }
+            }
+            break;
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
+
           default :
             /* Other options NOT YET SUPPORTED */
             __NOP(); /* result already set to COM_SOCKETS_ERR_PARAMETER */
@@ -1462,10 +1495,12 @@ int32_t com_setsockopt_ip_modem(int32_t sock, int32_t level, int32_t optname, co
   * @param  optname   - option name for which the value is requested
   * @note
   *         - COM_SO_SNDTIMEO, COM_SO_RCVTIMEO, COM_SO_ERROR supported
+  *         - COM_SO_TRANSPARENT supported if USE_SOCKETS_ONLINE_MODE == 1
   *         - any other value is rejected
   * @param  optval    - pointer to the buffer that will contain the option value
   * @note   COM_SO_SNDTIMEO, COM_SO_RCVTIMEO: in ms for timeout (uint32_t)
   *         COM_SO_ERROR : result of last operation (int32_t)
+  *         COM_SO_TRANSPARENT : 1 if transparent mode requested, 0 otherwise (uint32_t)
   * @param  optlen    - size of the buffer that will contain the option value
   * @note   must be sizeof(x32_t)
   * @retval int32_t   - ok or error value
@@ -1519,6 +1554,17 @@ int32_t com_getsockopt_ip_modem(int32_t sock, int32_t level, int32_t optname, vo
             }
             break;
 
+#if (USE_SOCKETS_ONLINE_MODE == 1)
+          /* Transparent access mode */
+          case COM_SO_TRANSPARENT :
+            if ((uint32_t)*optlen == sizeof(uint32_t))
+            {
+              *(uint32_t *)optval = (p_socket_desc->transparent == true) ? 1U : 0U;
+              result = COM_SOCKETS_ERR_OK;
+            }
+            break;
+#endif /* USE_SOCKETS_ONLINE_MODE == 1 */
+
           default :
             /* Other options NOT YET SUPPORTED */
             __NOP(); /* result already set to COM_SOCKETS_ERR_PARAMETER */
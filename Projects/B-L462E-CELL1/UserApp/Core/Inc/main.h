@@ -59,6 +59,8 @@ typedef MOTION_SENSOR_Axes_t bsp_axes_t;
 #define BSP_AXIS_X x
 #define BSP_AXIS_Y y
 #define BSP_AXIS_Z z
+#define BSP_TICKLESS_IDLE_LPTIM_CLKSOURCE RCC_LPTIM1CLKSOURCE_LSE
+#define BSP_TICKLESS_IDLE_LPTIM_CLK_HZ    LSE_VALUE
 /* USER CODE END EM */
 
 /* Exported functions prototypes ---------------------------------------------*/
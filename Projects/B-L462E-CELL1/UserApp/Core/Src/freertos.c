@@ -27,6 +27,7 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "application.h"
+#include "timer_slots.h"
 
 /* USER CODE END Includes */
 
@@ -147,7 +148,7 @@ void StartDefaultTask(void const * argument)
   /* Infinite loop */
   for(;;)
   {
-    osDelay(1);
+    osDelay(timer_slots_periodic_delay_ms(1000));
   }
   /* USER CODE END StartDefaultTask */
 }
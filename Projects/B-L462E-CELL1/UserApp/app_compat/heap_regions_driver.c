@@ -0,0 +1,32 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <heap_regions_driver.h>
+
+// The STM32L462 only has SRAM1 (128 KB at 0x20000000) and SRAM2 (32 KB at
+// 0x20020000, also aliased at 0x10000000). Both linker scripts cover them with
+// a single RAM region ending at 0x20028000, where the main stack starts: from
+// 0x20000000 without SBSFU, and from 0x20003000 with it, above the RAM of the
+// secure engine. The RAM2 region of the latter is the 0x10000000 alias of the
+// same SRAM2, with nothing placed in it. Adding SRAM2 to the heap would
+// overlap .bss and the main stack, so there is no bank left.
+
+size_t heap_regions_driver_get_banks(heap_regions_bank_t *out_banks,
+                                     size_t max_banks) {
+    (void) out_banks;
+    (void) max_banks;
+    return 0;
+}
@@ -144,6 +144,17 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* The tick is suppressed in idle with LPTIM1, see tickless_idle.h */
+#define configUSE_TICKLESS_IDLE 2
+/* Per-task CPU usage is measured with TIM2, see run_time_counter.h */
+#define configGENERATE_RUN_TIME_STATS 1
+#define configUSE_TRACE_FACILITY 1
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  void run_time_counter_init(void);
+  uint32_t run_time_counter_get(void);
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() run_time_counter_init()
+#define portGET_RUN_TIME_COUNTER_VALUE() run_time_counter_get()
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
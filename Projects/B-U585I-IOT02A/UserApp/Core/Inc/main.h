@@ -57,6 +57,9 @@ typedef BSP_MOTION_SENSOR_Axes_t bsp_axes_t;
 #define BSP_AXIS_X xval
 #define BSP_AXIS_Y yval
 #define BSP_AXIS_Z zval
+
+#define BSP_TICKLESS_IDLE_LPTIM_CLKSOURCE RCC_LPTIM1CLKSOURCE_LSI
+#define BSP_TICKLESS_IDLE_LPTIM_CLK_HZ    LSI_VALUE
 /* USER CODE END EM */
 
 /* Exported functions prototypes ---------------------------------------------*/
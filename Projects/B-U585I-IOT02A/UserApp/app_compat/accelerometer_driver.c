@@ -50,7 +50,33 @@ static int get_acceleration(three_axis_sensor_values_t *out_acceleration) {
     return 0;
 }
 
+static int accelerometer_set_power_state(sensor_power_state_t state,
+                                         float odr_hz) {
+    if (!g_sensor_accelerometer) {
+        LOG(ERROR, "Accelerometer not initialized");
+        return -1;
+    }
+    if (state == SENSOR_POWER_OFF) {
+        if (BSP_MOTION_SENSOR_Disable(0, MOTION_ACCELERO)) {
+            LOG(ERROR, "Accelerometer could not be disabled");
+            return -1;
+        }
+        return 0;
+    }
+    if (BSP_MOTION_SENSOR_Enable(0, MOTION_ACCELERO)) {
+        LOG(ERROR, "Accelerometer could not be enabled");
+        return -1;
+    }
+    if (BSP_MOTION_SENSOR_SetOutputDataRate(
+                0, MOTION_ACCELERO, sensor_power_odr_hz(state, odr_hz))) {
+        LOG(ERROR, "Accelerometer output data rate could not be set");
+        return -1;
+    }
+    return 0;
+}
+
 const three_axis_sensor_driver_t BSP_ACCELEROMETER_DRIVER = {
     .init = accelerometer_init,
-    .read = get_acceleration
+    .read = get_acceleration,
+    .set_power_state = accelerometer_set_power_state
 };
@@ -50,7 +50,30 @@ static int get_pressure(float *out_pressure) {
     return 0;
 }
 
+static int barometer_set_power_state(sensor_power_state_t state, float odr_hz) {
+    if (!g_sensor_barometer) {
+        LOG(ERROR, "Barometer not initialized");
+        return -1;
+    }
+    if (state == SENSOR_POWER_OFF) {
+        if (BSP_ENV_SENSOR_Disable(1, ENV_PRESSURE)) {
+            LOG(ERROR, "Barometer could not be disabled");
+            return -1;
+        }
+        return 0;
+    }
+    if (BSP_ENV_SENSOR_Enable(1, ENV_PRESSURE)
+            || BSP_ENV_SENSOR_SetOutputDataRate(
+                       1, ENV_PRESSURE,
+                       sensor_power_odr_hz(state, odr_hz))) {
+        LOG(ERROR, "Barometer could not be enabled");
+        return -1;
+    }
+    return 0;
+}
+
 const basic_sensor_driver_t BSP_BAROMETER_DRIVER = {
     .init = barometer_init,
-    .read = get_pressure
+    .read = get_pressure,
+    .set_power_state = barometer_set_power_state
 };
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <ext_ram_driver.h>
+
+#include <stdint.h>
+
+#include <avsystem/commons/avs_log.h>
+
+#include <b_u585i_iot02a_ospi.h>
+
+#define LOG(level, ...) avs_log(ext_ram_driver, level, __VA_ARGS__)
+
+// APS6408 octal PSRAM, on OCTOSPI1, memory-mapped at OCTOSPI1_BASE
+#define EXT_RAM_INSTANCE 0U
+#define EXT_RAM_SIZE APS6408_RAM_SIZE
+
+int ext_ram_driver_init(void **out_base, size_t *out_size) {
+    *out_base = NULL;
+    *out_size = 0;
+    if (BSP_OSPI_RAM_Init(EXT_RAM_INSTANCE)
+            || BSP_OSPI_RAM_EnableMemoryMappedMode(EXT_RAM_INSTANCE)) {
+        LOG(ERROR, "couldn't initialize PSRAM");
+        return -1;
+    }
+
+    *out_base = (void *) OCTOSPI1_BASE;
+    *out_size = EXT_RAM_SIZE;
+    return 0;
+}
@@ -31,6 +31,7 @@
 #include "config_persistence.h"
 #include "default_config.h"
 #include "firmware_update.h"
+#include "heap_regions.h"
 #include "region_defs.h"
 #include "utils.h"
 
@@ -38,6 +39,11 @@
 
 #define REQUIRED_FLASH_ALIGNMENT 16
 
+// The download is staged in a whole flash page when there is external RAM for
+// it, and in a small static batch of internal SRAM otherwise
+#define WRITER_BUF_EXT_RAM_WORDS (FLASH_PAGE_SIZE / sizeof(uint64_t))
+#define WRITER_BUF_WORDS 64
+
 typedef struct {
     uint32_t MaxSizeInBytes; /*!< The maximum allowed size for the FwImage in
                                 User Flash (in Bytes) */
@@ -61,7 +67,26 @@ static const uint32_t MagicTrailerValue[] = {
 // HACK: see flash_aligned_writer_t's docs on why we're not
 // writing the data directly into flash memory
 static flash_aligned_writer_t writer;
-static uint64_t writer_buf[64];
+static uint64_t writer_buf_static[WRITER_BUF_WORDS];
+static uint64_t *writer_buf;
+
+static uint64_t *writer_buf_alloc(size_t *out_words) {
+    uint64_t *buf = (uint64_t *) heap_regions_alloc(
+            WRITER_BUF_EXT_RAM_WORDS * sizeof(uint64_t), HEAP_REGIONS_COLD);
+    if (buf) {
+        *out_words = WRITER_BUF_EXT_RAM_WORDS;
+        return buf;
+    }
+    *out_words = AVS_ARRAY_SIZE(writer_buf_static);
+    return writer_buf_static;
+}
+
+static void writer_buf_free(void) {
+    if (writer_buf != writer_buf_static) {
+        heap_regions_free(writer_buf);
+    }
+    writer_buf = NULL;
+}
 
 static int
 flash_aligned_writer_cb(uint64_t *src, size_t offset_bytes, size_t len_bytes) {
@@ -105,10 +130,13 @@ static int fw_stream_open(void *user_ptr,
         }
     }
 
-    if (flash_aligned_writer_new(writer_buf, AVS_ARRAY_SIZE(writer_buf),
+    size_t writer_buf_words;
+    writer_buf = writer_buf_alloc(&writer_buf_words);
+    if (flash_aligned_writer_new(writer_buf, writer_buf_words,
                                  flash_aligned_writer_cb, &writer,
                                  REQUIRED_FLASH_ALIGNMENT)) {
         LOG(ERROR, "Buffer has wrong size");
+        writer_buf_free();
         return -1;
     }
 
@@ -141,6 +169,7 @@ static int fw_stream_finish(void *user_ptr) {
     (void) user_ptr;
 
     int res = flash_aligned_writer_flush(&writer);
+    writer_buf_free();
     if (res) {
         LOG(ERROR,
             "Failed to finish download: flash aligned writer flush failed, "
@@ -168,6 +197,7 @@ static int fw_stream_finish(void *user_ptr) {
 
 static void fw_reset(void *user_ptr) {
     (void) user_ptr;
+    writer_buf_free();
 }
 
 static void fw_update_reboot(avs_sched_t *sched, const void *data) {
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <heap_regions_driver.h>
+
+#include <stm32u5xx_hal.h>
+
+size_t heap_regions_driver_get_banks(heap_regions_bank_t *out_banks,
+                                     size_t max_banks) {
+#ifdef BL2
+    // With SBSFU, the secure application only makes SRAM1 non-secure
+    (void) out_banks;
+    (void) max_banks;
+    return 0;
+#else  // BL2
+    // SRAM1 to SRAM3 make up the RAM region of the linker script. SRAM4 is
+    // declared too, but nothing is placed there; it sits on the AHB3 bus of
+    // the SmartRun domain, so it is the last region of the heap.
+    if (max_banks < 1) {
+        return 0;
+    }
+    __HAL_RCC_SRAM4_CLK_ENABLE();
+    out_banks[0] = (heap_regions_bank_t) {
+        .base = (uint8_t *) SRAM4_BASE_NS,
+        .size = SRAM4_SIZE
+    };
+    return 1;
+#endif // BL2
+}
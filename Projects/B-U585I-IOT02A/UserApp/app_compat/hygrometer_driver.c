@@ -44,7 +44,31 @@ static int get_humidity(float *out_humidity) {
     return 0;
 }
 
+static int hygrometer_set_power_state(sensor_power_state_t state,
+                                      float odr_hz) {
+    if (!g_sensor_hygrometer) {
+        LOG(ERROR, "Hygrometer not initialized");
+        return -1;
+    }
+    if (state == SENSOR_POWER_OFF) {
+        if (BSP_ENV_SENSOR_Disable(0, ENV_HUMIDITY)) {
+            LOG(ERROR, "Hygrometer could not be disabled");
+            return -1;
+        }
+        return 0;
+    }
+    if (BSP_ENV_SENSOR_Enable(0, ENV_HUMIDITY)
+            || BSP_ENV_SENSOR_SetOutputDataRate(
+                       0, ENV_HUMIDITY,
+                       sensor_power_odr_hz(state, odr_hz))) {
+        LOG(ERROR, "Hygrometer could not be enabled");
+        return -1;
+    }
+    return 0;
+}
+
 const basic_sensor_driver_t BSP_HYGROMETER_DRIVER = {
     .init = hygrometer_init,
-    .read = get_humidity
+    .read = get_humidity,
+    .set_power_state = hygrometer_set_power_state
 };
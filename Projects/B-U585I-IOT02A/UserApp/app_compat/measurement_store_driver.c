@@ -0,0 +1,100 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <measurement_store_driver.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <avsystem/commons/avs_defs.h>
+
+#ifdef NVM_USE_OSPI
+#include <b_u585i_iot02a_ospi.h>
+
+#include <nvm_partition.h>
+
+// we're using the 4K sectors of blocks 3-6 of OSPI NOR flash, right after the
+// blocks used by nvm_partition_driver.c
+
+#define FIRST_SECTOR \
+    (_NVM_PARTITION_COUNT * BSP_OSPI_NOR_BLOCK_64K / BSP_OSPI_NOR_BLOCK_4K)
+#define SECTOR_COUNT 64U
+
+AVS_STATIC_ASSERT(BSP_OSPI_NOR_BLOCK_4K == MEASUREMENT_STORE_SECTOR_SIZE,
+                  sector_size_matches);
+#else // NVM_USE_OSPI
+// the EEPROM is too small and wears out too quickly to hold measurements, so
+// the store is disabled
+#define SECTOR_COUNT 0U
+#endif // NVM_USE_OSPI
+
+static inline bool fits(size_t sector, size_t offset, size_t op_len) {
+    return sector < SECTOR_COUNT
+           && offset + op_len <= MEASUREMENT_STORE_SECTOR_SIZE;
+}
+
+#ifdef NVM_USE_OSPI
+static inline uint32_t sector_start(size_t sector) {
+    return (FIRST_SECTOR + sector) * MEASUREMENT_STORE_SECTOR_SIZE;
+}
+#endif // NVM_USE_OSPI
+
+size_t measurement_store_driver_sector_count(void) {
+    return SECTOR_COUNT;
+}
+
+int measurement_store_driver_read(size_t sector,
+                                  size_t offset,
+                                  void *out_data,
+                                  size_t out_data_len) {
+    if (!fits(sector, offset, out_data_len)) {
+        return -1;
+    }
+#ifdef NVM_USE_OSPI
+    return BSP_OSPI_NOR_Read(0, (uint8_t *) out_data,
+                             sector_start(sector) + offset, out_data_len);
+#else  // NVM_USE_OSPI
+    return -1;
+#endif // NVM_USE_OSPI
+}
+
+int measurement_store_driver_write(size_t sector,
+                                   size_t offset,
+                                   const void *data,
+                                   size_t data_len) {
+    if (!fits(sector, offset, data_len)) {
+        return -1;
+    }
+#ifdef NVM_USE_OSPI
+    return BSP_OSPI_NOR_Write(0, (uint8_t *) data,
+                              sector_start(sector) + offset, data_len);
+#else  // NVM_USE_OSPI
+    return -1;
+#endif // NVM_USE_OSPI
+}
+
+int measurement_store_driver_erase(size_t sector) {
+    if (sector >= SECTOR_COUNT) {
+        return -1;
+    }
+#ifdef NVM_USE_OSPI
+    return BSP_OSPI_NOR_Erase_Block(0, sector_start(sector),
+                                    BSP_OSPI_NOR_ERASE_4K);
+#else  // NVM_USE_OSPI
+    return -1;
+#endif // NVM_USE_OSPI
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+
+#include "main.h"
+#include "stm32u5xx_ll_tim.h"
+
+#include "run_time_counter.h"
+
+void run_time_counter_init(void) {
+    // Timers are clocked at twice PCLK1 whenever APB1 is prescaled
+    uint32_t tim_clk_hz = HAL_RCC_GetPCLK1Freq();
+    if (tim_clk_hz != HAL_RCC_GetHCLKFreq()) {
+        tim_clk_hz *= 2U;
+    }
+
+    __HAL_RCC_TIM2_CLK_ENABLE();
+    LL_TIM_SetPrescaler(TIM2, tim_clk_hz / RUN_TIME_COUNTER_HZ - 1U);
+    LL_TIM_SetAutoReload(TIM2, UINT32_MAX);
+    // The prescaler is only loaded on an update event
+    LL_TIM_GenerateEvent_UPDATE(TIM2);
+    LL_TIM_EnableCounter(TIM2);
+}
+
+uint32_t run_time_counter_get(void) {
+    return LL_TIM_GetCounter(TIM2);
+}
@@ -44,7 +44,31 @@ static int get_temperature(float *out_temperature) {
     return 0;
 }
 
+static int thermometer_set_power_state(sensor_power_state_t state,
+                                       float odr_hz) {
+    if (!g_sensor_thermometer) {
+        LOG(ERROR, "Thermometer not initialized");
+        return -1;
+    }
+    if (state == SENSOR_POWER_OFF) {
+        if (BSP_ENV_SENSOR_Disable(0, ENV_TEMPERATURE)) {
+            LOG(ERROR, "Thermometer could not be disabled");
+            return -1;
+        }
+        return 0;
+    }
+    if (BSP_ENV_SENSOR_Enable(0, ENV_TEMPERATURE)
+            || BSP_ENV_SENSOR_SetOutputDataRate(
+                       0, ENV_TEMPERATURE,
+                       sensor_power_odr_hz(state, odr_hz))) {
+        LOG(ERROR, "Thermometer could not be enabled");
+        return -1;
+    }
+    return 0;
+}
+
 const basic_sensor_driver_t BSP_THERMOMETER_DRIVER = {
     .init = thermometer_init,
-    .read = get_temperature
+    .read = get_temperature,
+    .set_power_state = thermometer_set_power_state
 };
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "main.h"
+#include "stm32u5xx_ll_lptim.h"
+#include "task.h"
+
+#include "tickless_idle.h"
+
+#define TICKLESS_IDLE_LPTIM_HZ (BSP_TICKLESS_IDLE_LPTIM_CLK_HZ / 16U)
+#define TICKLESS_IDLE_MAX_COUNTS 0xFFFFU
+// The idle period has to cover the LPTIM synchronization delays
+#define TICKLESS_IDLE_MIN_COUNTS 4U
+
+static volatile bool g_initialized;
+static tickless_idle_stats_t g_stats;
+
+static uint32_t ticks_to_counts(TickType_t ticks) {
+    return (uint32_t) ((uint64_t) ticks * TICKLESS_IDLE_LPTIM_HZ
+                       / configTICK_RATE_HZ);
+}
+
+static TickType_t counts_to_ticks(uint32_t counts) {
+    return (TickType_t) ((uint64_t) counts * configTICK_RATE_HZ
+                         / TICKLESS_IDLE_LPTIM_HZ);
+}
+
+static uint32_t read_counter(void) {
+    // The counter runs asynchronously, so it is valid only if read twice
+    uint32_t counter;
+    do {
+        counter = LL_LPTIM_GetCounter(LPTIM1);
+    } while (counter != LL_LPTIM_GetCounter(LPTIM1));
+    return counter;
+}
+
+void tickless_idle_init(void) {
+    __HAL_RCC_LPTIM1_CONFIG(BSP_TICKLESS_IDLE_LPTIM_CLKSOURCE);
+    __HAL_RCC_LPTIM1_CLK_ENABLE();
+
+    // The prescaler can only be modified while LPTIM1 is disabled, and the
+    // interrupt enable register while it is enabled
+    LL_LPTIM_SetPrescaler(LPTIM1, LL_LPTIM_PRESCALER_DIV16);
+    LL_LPTIM_Enable(LPTIM1);
+    LL_LPTIM_ClearFlag_DIEROK(LPTIM1);
+    LL_LPTIM_EnableIT_ARRM(LPTIM1);
+    while (!LL_LPTIM_IsActiveFlag_DIEROK(LPTIM1)) {
+    }
+    LL_LPTIM_Disable(LPTIM1);
+
+    // Only wakes the MCU up, so it does not interact with the RTOS
+    HAL_NVIC_SetPriority(LPTIM1_IRQn, 15, 0);
+    HAL_NVIC_EnableIRQ(LPTIM1_IRQn);
+    g_initialized = true;
+}
+
+tickless_idle_stats_t tickless_idle_get_stats(void) {
+    taskENTER_CRITICAL();
+    tickless_idle_stats_t stats = g_stats;
+    taskEXIT_CRITICAL();
+    return stats;
+}
+
+void vPortSuppressTicksAndSleep(TickType_t expected_idle_ticks) {
+    if (!g_initialized) {
+        return;
+    }
+    uint32_t counts = ticks_to_counts(expected_idle_ticks);
+    if (counts > TICKLESS_IDLE_MAX_COUNTS) {
+        counts = TICKLESS_IDLE_MAX_COUNTS;
+    }
+    if (counts < TICKLESS_IDLE_MIN_COUNTS) {
+        return;
+    }
+
+    __disable_irq();
+    __DSB();
+    __ISB();
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep) {
+        __enable_irq();
+        return;
+    }
+
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    HAL_SuspendTick();
+
+    // Enabling LPTIM1 resets its counter; the autoreload register can only be
+    // written while it is enabled
+    LL_LPTIM_Enable(LPTIM1);
+    LL_LPTIM_ClearFlag_ARROK(LPTIM1);
+    LL_LPTIM_SetAutoReload(LPTIM1, counts);
+    while (!LL_LPTIM_IsActiveFlag_ARROK(LPTIM1)) {
+    }
+    LL_LPTIM_StartCounter(LPTIM1, LL_LPTIM_OPERATING_MODE_CONTINUOUS);
+
+    __DSB();
+    __WFI();
+    __ISB();
+
+    uint32_t elapsed =
+            LL_LPTIM_IsActiveFlag_ARRM(LPTIM1) ? counts : read_counter();
+    LL_LPTIM_Disable(LPTIM1);
+    LL_LPTIM_ClearFLAG_ARRM(LPTIM1);
+    NVIC_ClearPendingIRQ(LPTIM1_IRQn);
+
+    // The tick in progress when the sleep ends is completed by SysTick
+    TickType_t elapsed_ticks = counts_to_ticks(elapsed);
+    if (elapsed_ticks >= expected_idle_ticks) {
+        elapsed_ticks = expected_idle_ticks - 1;
+    }
+    vTaskStepTick(elapsed_ticks);
+    uwTick += elapsed_ticks;
+    g_stats.sleep_ticks += elapsed_ticks;
+    g_stats.sleeps++;
+
+    HAL_ResumeTick();
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    __enable_irq();
+}
+
+void LPTIM1_IRQHandler(void) {
+    // The flag is normally cleared before interrupts are enabled again
+    LL_LPTIM_ClearFLAG_ARRM(LPTIM1);
+}
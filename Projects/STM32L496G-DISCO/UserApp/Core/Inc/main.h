@@ -61,6 +61,14 @@ typedef SensorAxes_t bsp_axes_t;
 #define BSP_AXIS_X AXIS_X
 #define BSP_AXIS_Y AXIS_Y
 #define BSP_AXIS_Z AXIS_Z
+
+/* IKS01A2 LSM6DSL INT1, used as the FIFO watermark interrupt; EXTI line 11
+ * is already served in EXTI15_10_IRQHandler() through JOY_RIGHT_Pin */
+#define BSP_MOTION_FIFO_INT_PIN   ARD_D4_Pin
+#define BSP_MOTION_FIFO_INT_PORT  ARD_D4_GPIO_Port
+#define BSP_MOTION_FIFO_INT_IRQn  EXTI15_10_IRQn
+#define BSP_TICKLESS_IDLE_LPTIM_CLKSOURCE RCC_LPTIM1CLKSOURCE_LSI
+#define BSP_TICKLESS_IDLE_LPTIM_CLK_HZ    LSI_VALUE
 /* USER CODE END EM */
 
 /* Exported functions prototypes ---------------------------------------------*/
@@ -48,6 +48,7 @@ void MX_QUADSPI_Init(void);
 uint8_t BSP_QSPI_Read(uint8_t *pData, uint32_t ReadAddr, uint32_t Size);
 uint8_t BSP_QSPI_Write(uint8_t *pData, uint32_t WriteAddr, uint32_t Size);
 uint8_t BSP_QSPI_Erase_Block(uint32_t BlockAddress);
+uint8_t BSP_QSPI_Erase_Sector(uint32_t SectorAddress);
 /* USER CODE END Prototypes */
 
 #ifdef __cplusplus
@@ -27,6 +27,7 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "application.h"
+#include "timer_slots.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -149,7 +150,7 @@ void StartDefaultTask(void const * argument)
 #ifdef HAL_IWDG_MODULE_ENABLED
 	  WRITE_REG(IWDG->KR, IWDG_KEY_RELOAD);
 #endif
-    osDelay(1000);
+    osDelay(timer_slots_periodic_delay_ms(1000));
   }
   /* USER CODE END StartDefaultTask */
 }
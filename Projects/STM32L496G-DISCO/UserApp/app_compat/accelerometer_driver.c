@@ -14,14 +14,18 @@
  * limitations under the License.
  */
 
+#include <stdbool.h>
+
 #include <avsystem/commons/avs_log.h>
 #define LOG(level, ...) avs_log(accelerometer_driver, level, __VA_ARGS__)
 
+#include "sensor_drivers/motion_fifo.h"
 #include "sensor_drivers/three_axis_sensor_driver.h"
 #include "x_nucleo_iks01a2.h"
 #include "x_nucleo_iks01a2_accelero.h"
 
 static void *g_sensor_accelerometer = NULL;
+static bool g_accelerometer_batched;
 
 static int accelerometer_init(void) {
     uint8_t status = 0U;
@@ -38,6 +42,11 @@ static int accelerometer_init(void) {
         LOG(ERROR, "IKS01A2 accelerometer could not be enabled");
         return -1;
     }
+    g_accelerometer_batched = !motion_fifo_enable(MOTION_FIFO_ACCELEROMETER,
+                                                  g_sensor_accelerometer);
+    if (!g_accelerometer_batched) {
+        LOG(WARNING, "IKS01A2 accelerometer FIFO unavailable, polling");
+    }
     return 0;
 }
 
@@ -57,7 +66,52 @@ static int get_acceleration(three_axis_sensor_values_t *out_acceleration) {
     return 0;
 }
 
+static int
+get_acceleration_window(three_axis_sensor_window_t *out_acceleration) {
+    if (motion_fifo_read_window(MOTION_FIFO_ACCELEROMETER, out_acceleration)) {
+        return -1;
+    }
+    // Convert from mg to m/s^2
+    three_axis_sensor_scale_window(out_acceleration, 1e-3 * G_TO_MS2);
+    return 0;
+}
+
+static int accelerometer_set_power_state(sensor_power_state_t state,
+                                         float odr_hz) {
+    if (!g_sensor_accelerometer) {
+        LOG(ERROR, "IKS01A2 accelerometer not initialized");
+        return -1;
+    }
+    if (state == SENSOR_POWER_OFF) {
+        if ((g_accelerometer_batched
+             && motion_fifo_disable(MOTION_FIFO_ACCELEROMETER))
+                || BSP_ACCELERO_Sensor_Disable(g_sensor_accelerometer)) {
+            LOG(ERROR, "IKS01A2 accelerometer could not be disabled");
+            return -1;
+        }
+        return 0;
+    }
+    if (BSP_ACCELERO_Sensor_Enable(g_sensor_accelerometer)) {
+        LOG(ERROR, "IKS01A2 accelerometer could not be enabled");
+        return -1;
+    }
+    // While batched, the sensor keeps its default output data rate, above the
+    // batch data rate of the FIFO
+    if (g_accelerometer_batched
+            ? motion_fifo_enable(MOTION_FIFO_ACCELEROMETER,
+                                 g_sensor_accelerometer)
+            : BSP_ACCELERO_Set_ODR_Value(
+                      g_sensor_accelerometer,
+                      sensor_power_odr_hz(state, odr_hz))) {
+        LOG(ERROR, "IKS01A2 accelerometer output data rate could not be set");
+        return -1;
+    }
+    return 0;
+}
+
 const three_axis_sensor_driver_t BSP_ACCELEROMETER_DRIVER = {
     .init = accelerometer_init,
-    .read = get_acceleration
+    .read = get_acceleration,
+    .read_window = get_acceleration_window,
+    .set_power_state = accelerometer_set_power_state
 };
@@ -59,7 +59,30 @@ static int get_pressure(float *out_pressure) {
     return 0;
 }
 
+static int barometer_set_power_state(sensor_power_state_t state, float odr_hz) {
+    if (!g_sensor_barometer) {
+        LOG(ERROR, "IKS01A2 barometer not initialized");
+        return -1;
+    }
+    if (state == SENSOR_POWER_OFF) {
+        if (BSP_PRESSURE_Sensor_Disable(g_sensor_barometer)) {
+            LOG(ERROR, "IKS01A2 barometer could not be disabled");
+            return -1;
+        }
+        return 0;
+    }
+    if (BSP_PRESSURE_Sensor_Enable(g_sensor_barometer)
+            || BSP_PRESSURE_Set_ODR_Value(
+                       g_sensor_barometer,
+                       sensor_power_odr_hz(state, odr_hz))) {
+        LOG(ERROR, "IKS01A2 barometer could not be enabled");
+        return -1;
+    }
+    return 0;
+}
+
 const basic_sensor_driver_t BSP_BAROMETER_DRIVER = {
     .init = barometer_init,
-    .read = get_pressure
+    .read = get_pressure,
+    .set_power_state = barometer_set_power_state
 };
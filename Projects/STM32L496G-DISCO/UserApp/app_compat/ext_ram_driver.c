@@ -0,0 +1,27 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <ext_ram_driver.h>
+
+// The FMC SRAM of the board is not used, its BSP driver is not part of the
+// project
+
+int ext_ram_driver_init(void **out_base, size_t *out_size) {
+    *out_base = NULL;
+    *out_size = 0;
+    return 0;
+}
@@ -14,14 +14,18 @@
  * limitations under the License.
  */
 
+#include <stdbool.h>
+
 #include <avsystem/commons/avs_log.h>
 #define LOG(level, ...) avs_log(gyrometer_driver, level, __VA_ARGS__)
 
+#include "sensor_drivers/motion_fifo.h"
 #include "sensor_drivers/three_axis_sensor_driver.h"
 #include "x_nucleo_iks01a2.h"
 #include "x_nucleo_iks01a2_gyro.h"
 
 static void *g_sensor_gyrometer = NULL;
+static bool g_gyrometer_batched;
 
 static int gyrometer_init(void) {
     uint8_t status = 0U;
@@ -37,6 +41,11 @@ static int gyrometer_init(void) {
         LOG(ERROR, "IKS01A2 gyrometer could not be enabled");
         return -1;
     }
+    g_gyrometer_batched =
+            !motion_fifo_enable(MOTION_FIFO_GYROMETER, g_sensor_gyrometer);
+    if (!g_gyrometer_batched) {
+        LOG(WARNING, "IKS01A2 gyrometer FIFO unavailable, polling");
+    }
     return 0;
 }
 
@@ -57,7 +66,49 @@ get_angular_velocity(three_axis_sensor_values_t *out_angular_velocity) {
     return 0;
 }
 
+static int
+get_angular_velocity_window(three_axis_sensor_window_t *out_angular_velocity) {
+    if (motion_fifo_read_window(MOTION_FIFO_GYROMETER, out_angular_velocity)) {
+        return -1;
+    }
+    // Convert from mdeg/s to deg/s
+    three_axis_sensor_scale_window(out_angular_velocity, 0.001f);
+    return 0;
+}
+
+static int gyrometer_set_power_state(sensor_power_state_t state, float odr_hz) {
+    if (!g_sensor_gyrometer) {
+        LOG(ERROR, "IKS01A2 gyrometer not initialized");
+        return -1;
+    }
+    if (state == SENSOR_POWER_OFF) {
+        if ((g_gyrometer_batched
+             && motion_fifo_disable(MOTION_FIFO_GYROMETER))
+                || BSP_GYRO_Sensor_Disable(g_sensor_gyrometer)) {
+            LOG(ERROR, "IKS01A2 gyrometer could not be disabled");
+            return -1;
+        }
+        return 0;
+    }
+    if (BSP_GYRO_Sensor_Enable(g_sensor_gyrometer)) {
+        LOG(ERROR, "IKS01A2 gyrometer could not be enabled");
+        return -1;
+    }
+    // While batched, the sensor keeps its default output data rate, above the
+    // batch data rate of the FIFO
+    if (g_gyrometer_batched
+            ? motion_fifo_enable(MOTION_FIFO_GYROMETER, g_sensor_gyrometer)
+            : BSP_GYRO_Set_ODR_Value(g_sensor_gyrometer,
+                                     sensor_power_odr_hz(state, odr_hz))) {
+        LOG(ERROR, "IKS01A2 gyrometer output data rate could not be set");
+        return -1;
+    }
+    return 0;
+}
+
 const three_axis_sensor_driver_t BSP_GYROMETER_DRIVER = {
     .init = gyrometer_init,
-    .read = get_angular_velocity
+    .read = get_angular_velocity,
+    .read_window = get_angular_velocity_window,
+    .set_power_state = gyrometer_set_power_state
 };
@@ -0,0 +1,31 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <heap_regions_driver.h>
+
+// The STM32L496 only has SRAM1 (256 KB at 0x20000000) and SRAM2 (64 KB at
+// 0x20040000, also aliased at 0x10000000). Both linker scripts already cover
+// them with a single region ending at 0x20050000, where the main stack starts:
+// RAM from 0x20000000 without SBSFU, and APPLI_region_RAM from 0x20001000 with
+// it, below the RAM protected by the firewall. Adding SRAM2 to the heap would
+// overlap .bss and the main stack, so there is no bank left.
+
+size_t heap_regions_driver_get_banks(heap_regions_bank_t *out_banks,
+                                     size_t max_banks) {
+    (void) out_banks;
+    (void) max_banks;
+    return 0;
+}
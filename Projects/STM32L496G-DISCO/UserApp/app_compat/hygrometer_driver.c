@@ -53,7 +53,31 @@ static int get_humidity(float *out_humidity) {
     return 0;
 }
 
+static int hygrometer_set_power_state(sensor_power_state_t state,
+                                      float odr_hz) {
+    if (!g_sensor_hygrometer) {
+        LOG(ERROR, "IKS01A2 hygrometer not initialized");
+        return -1;
+    }
+    if (state == SENSOR_POWER_OFF) {
+        if (BSP_HUMIDITY_Sensor_Disable(g_sensor_hygrometer)) {
+            LOG(ERROR, "IKS01A2 hygrometer could not be disabled");
+            return -1;
+        }
+        return 0;
+    }
+    if (BSP_HUMIDITY_Sensor_Enable(g_sensor_hygrometer)
+            || BSP_HUMIDITY_Set_ODR_Value(
+                       g_sensor_hygrometer,
+                       sensor_power_odr_hz(state, odr_hz))) {
+        LOG(ERROR, "IKS01A2 hygrometer could not be enabled");
+        return -1;
+    }
+    return 0;
+}
+
 const basic_sensor_driver_t BSP_HYGROMETER_DRIVER = {
     .init = hygrometer_init,
-    .read = get_humidity
+    .read = get_humidity,
+    .set_power_state = hygrometer_set_power_state
 };
@@ -56,7 +56,31 @@ static int get_magnetism(three_axis_sensor_values_t *out_magnetism) {
     return 0;
 }
 
+static int magnetometer_set_power_state(sensor_power_state_t state,
+                                        float odr_hz) {
+    if (!g_sensor_magnetometer) {
+        LOG(ERROR, "IKS01A2 magnetometer not initialized");
+        return -1;
+    }
+    if (state == SENSOR_POWER_OFF) {
+        if (BSP_MAGNETO_Sensor_Disable(g_sensor_magnetometer)) {
+            LOG(ERROR, "IKS01A2 magnetometer could not be disabled");
+            return -1;
+        }
+        return 0;
+    }
+    if (BSP_MAGNETO_Sensor_Enable(g_sensor_magnetometer)
+            || BSP_MAGNETO_Set_ODR_Value(
+                       g_sensor_magnetometer,
+                       sensor_power_odr_hz(state, odr_hz))) {
+        LOG(ERROR, "IKS01A2 magnetometer could not be enabled");
+        return -1;
+    }
+    return 0;
+}
+
 const three_axis_sensor_driver_t BSP_MAGNETOMETER_DRIVER = {
     .init = magnetometer_init,
-    .read = get_magnetism
+    .read = get_magnetism,
+    .set_power_state = magnetometer_set_power_state
 };
@@ -0,0 +1,266 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmsis_os.h>
+
+#include <avsystem/commons/avs_log.h>
+#define LOG(level, ...) avs_log(motion_fifo, level, __VA_ARGS__)
+
+#include "LSM6DSL_ACC_GYRO_driver.h"
+#include "main.h"
+#include "sensor_acquisition.h"
+#include "sensor_drivers/motion_fifo.h"
+#include "x_nucleo_iks01a2.h"
+#include "x_nucleo_iks01a2_accelero.h"
+#include "x_nucleo_iks01a2_gyro.h"
+
+// FIFO data rate of each batched sensor; the sensor ODRs are higher
+#define MOTION_FIFO_ODR LSM6DSL_ACC_GYRO_ODR_FIFO_25Hz
+// FIFO watermark, in 16-bit words (one axis of one sample); with both sensors
+// batched, about one second
+#define MOTION_FIFO_WATERMARK 156U
+#define MOTION_FIFO_BURST_WORDS MOTION_FIFO_WATERMARK
+
+static osMutexId g_motion_fifo_mutex;
+static sensor_acquisition_work_t g_drain_work;
+static bool g_configured;
+// Handles returned by the BSP, non-NULL for batched sensors
+static void *g_handles[MOTION_FIFO_SENSORS_COUNT];
+static motion_fifo_stats_t g_stats[MOTION_FIFO_SENSORS_COUNT];
+static uint8_t g_burst_buf[MOTION_FIFO_BURST_WORDS * 2];
+
+// The FIFO holds the axes of the batched sensors one after another: gyrometer
+// first, then accelerometer
+static motion_fifo_sensor_t g_pattern[MOTION_FIFO_SENSORS_COUNT];
+static size_t g_pattern_sensors;
+// Axes of the sample being read, which may be split between bursts
+static int16_t g_partial_sample[3];
+
+static void *get_handle(void) {
+    return g_handles[MOTION_FIFO_ACCELEROMETER]
+                   ? g_handles[MOTION_FIFO_ACCELEROMETER]
+                   : g_handles[MOTION_FIFO_GYROMETER];
+}
+
+static int drain_locked(void) {
+    if (!g_pattern_sensors) {
+        return 0;
+    }
+
+    void *handle = get_handle();
+    uint16_t words;
+    uint16_t pattern;
+    if (LSM6DSL_ACC_GYRO_R_FIFONumOfEntries(handle, &words) == MEMS_ERROR
+            || LSM6DSL_ACC_GYRO_R_FIFOPattern(handle, &pattern)
+                           == MEMS_ERROR) {
+        LOG(ERROR, "couldn't read FIFO status");
+        return -1;
+    }
+
+    size_t pattern_words = 3 * g_pattern_sensors;
+    while (words > 0) {
+        uint16_t burst_words =
+                words < MOTION_FIFO_BURST_WORDS ? words
+                                                : MOTION_FIFO_BURST_WORDS;
+        // The address rolls back to FIFO_DATA_OUT_L after each word
+        if (LSM6DSL_ACC_GYRO_ReadReg(handle, LSM6DSL_ACC_GYRO_FIFO_DATA_OUT_L,
+                                     g_burst_buf,
+                                     (uint16_t) (burst_words * 2))
+                == MEMS_ERROR) {
+            LOG(ERROR, "couldn't read FIFO data");
+            return -1;
+        }
+        for (uint16_t i = 0; i < burst_words; i++) {
+            size_t axis = pattern % 3;
+            g_partial_sample[axis] =
+                    (int16_t) ((uint16_t) g_burst_buf[2 * i]
+                               | ((uint16_t) g_burst_buf[2 * i + 1] << 8));
+            if (axis == 2) {
+                motion_fifo_stats_add(&g_stats[g_pattern[pattern / 3]],
+                                      g_partial_sample);
+            }
+            pattern = (uint16_t) ((pattern + 1) % pattern_words);
+        }
+        words -= burst_words;
+    }
+    return 0;
+}
+
+// Called from the sensor acquisition task
+static void drain(void) {
+    (void) osMutexWait(g_motion_fifo_mutex, osWaitForever);
+    (void) drain_locked();
+    (void) osMutexRelease(g_motion_fifo_mutex);
+}
+
+// Restarts the FIFO with the batched sensors, which discards its content, so
+// it has to be drained first
+static int configure_fifo_locked(void) {
+    void *handle = get_handle();
+
+    g_pattern_sensors = 0;
+    if (g_handles[MOTION_FIFO_GYROMETER]) {
+        g_pattern[g_pattern_sensors++] = MOTION_FIFO_GYROMETER;
+    }
+    if (g_handles[MOTION_FIFO_ACCELEROMETER]) {
+        g_pattern[g_pattern_sensors++] = MOTION_FIFO_ACCELEROMETER;
+    }
+
+    if (LSM6DSL_ACC_GYRO_W_FIFO_MODE(handle,
+                                     LSM6DSL_ACC_GYRO_FIFO_MODE_BYPASS)
+                    == MEMS_ERROR
+            || LSM6DSL_ACC_GYRO_W_DEC_FIFO_XL(
+                       handle,
+                       g_handles[MOTION_FIFO_ACCELEROMETER]
+                               ? LSM6DSL_ACC_GYRO_DEC_FIFO_XL_NO_DECIMATION
+                               : LSM6DSL_ACC_GYRO_DEC_FIFO_XL_DATA_NOT_IN_FIFO)
+                           == MEMS_ERROR
+            || LSM6DSL_ACC_GYRO_W_DEC_FIFO_G(
+                       handle,
+                       g_handles[MOTION_FIFO_GYROMETER]
+                               ? LSM6DSL_ACC_GYRO_DEC_FIFO_G_NO_DECIMATION
+                               : LSM6DSL_ACC_GYRO_DEC_FIFO_G_DATA_NOT_IN_FIFO)
+                           == MEMS_ERROR
+            || LSM6DSL_ACC_GYRO_W_ODR_FIFO(handle, MOTION_FIFO_ODR)
+                           == MEMS_ERROR
+            || LSM6DSL_ACC_GYRO_W_FIFO_Watermark(handle, MOTION_FIFO_WATERMARK)
+                           == MEMS_ERROR
+            || LSM6DSL_ACC_GYRO_W_FIFO_TSHLD_on_INT1(
+                       handle, LSM6DSL_ACC_GYRO_INT1_FTH_ENABLED)
+                           == MEMS_ERROR
+            // Continuous mode: the oldest samples are overwritten if the FIFO
+            // is not drained in time
+            || LSM6DSL_ACC_GYRO_W_FIFO_MODE(
+                       handle, LSM6DSL_ACC_GYRO_FIFO_MODE_DYN_STREAM_2)
+                           == MEMS_ERROR) {
+        return -1;
+    }
+    return 0;
+}
+
+static void configure_interrupt(void) {
+    // INT1 is a level signal, which stays high while the FIFO level is above
+    // the watermark, so each drain rearms the edge. The pin is configured as
+    // the ARD_D4 output by default. EXTI line 11 is taken over from
+    // JOY_RIGHT (PF11), which is only ever polled.
+    GPIO_InitTypeDef gpio_init = {
+        .Pin = BSP_MOTION_FIFO_INT_PIN,
+        .Mode = GPIO_MODE_IT_RISING,
+        .Pull = GPIO_NOPULL,
+        .Speed = GPIO_SPEED_FREQ_LOW
+    };
+    HAL_GPIO_Init(BSP_MOTION_FIFO_INT_PORT, &gpio_init);
+    // EXTI15_10 is already enabled for the joystick
+    HAL_NVIC_EnableIRQ(BSP_MOTION_FIFO_INT_IRQn);
+}
+
+int motion_fifo_enable(motion_fifo_sensor_t sensor, void *bsp_handle) {
+    if (!bsp_handle) {
+        return -1;
+    }
+
+    if (!g_configured) {
+        osMutexDef(motion_fifo_mutex);
+        g_motion_fifo_mutex = osMutexCreate(osMutex(motion_fifo_mutex));
+        if (!g_motion_fifo_mutex
+                || sensor_acquisition_register_work(&g_drain_work, drain)) {
+            LOG(ERROR, "couldn't initialize FIFO");
+            return -1;
+        }
+        configure_interrupt();
+        g_configured = true;
+    }
+
+    (void) osMutexWait(g_motion_fifo_mutex, osWaitForever);
+    int result = 0;
+    if (!g_handles[sensor]) {
+        (void) drain_locked();
+        g_handles[sensor] = bsp_handle;
+        g_stats[sensor] = (motion_fifo_stats_t) { 0 };
+        result = configure_fifo_locked();
+        if (result) {
+            LOG(ERROR, "couldn't configure FIFO");
+            g_handles[sensor] = NULL;
+        }
+    }
+    (void) osMutexRelease(g_motion_fifo_mutex);
+    return result;
+}
+
+int motion_fifo_disable(motion_fifo_sensor_t sensor) {
+    if (!g_configured) {
+        return -1;
+    }
+
+    (void) osMutexWait(g_motion_fifo_mutex, osWaitForever);
+    void *handle = g_handles[sensor];
+    int result = 0;
+    if (handle) {
+        (void) drain_locked();
+        g_handles[sensor] = NULL;
+        if (get_handle()) {
+            result = configure_fifo_locked();
+        } else {
+            g_pattern_sensors = 0;
+            if (LSM6DSL_ACC_GYRO_W_FIFO_MODE(
+                        handle, LSM6DSL_ACC_GYRO_FIFO_MODE_BYPASS)
+                    == MEMS_ERROR) {
+                result = -1;
+            }
+        }
+        if (result) {
+            LOG(ERROR, "couldn't configure FIFO");
+        }
+    }
+    (void) osMutexRelease(g_motion_fifo_mutex);
+    return result;
+}
+
+int motion_fifo_read_window(motion_fifo_sensor_t sensor,
+                            three_axis_sensor_window_t *out_window) {
+    void *handle = g_handles[sensor];
+    if (!handle) {
+        return -1;
+    }
+
+    float sensitivity;
+    if ((sensor == MOTION_FIFO_ACCELEROMETER
+                 ? BSP_ACCELERO_Get_Sensitivity(handle, &sensitivity)
+                 : BSP_GYRO_Get_Sensitivity(handle, &sensitivity))
+            != COMPONENT_OK) {
+        return -1;
+    }
+
+    (void) osMutexWait(g_motion_fifo_mutex, osWaitForever);
+    // Samples still below the watermark belong to this window as well
+    int result = drain_locked();
+    if (!result) {
+        result = motion_fifo_stats_pop(&g_stats[sensor], sensitivity,
+                                       out_window);
+    }
+    (void) osMutexRelease(g_motion_fifo_mutex);
+    return result;
+}
+
+void motion_fifo_irq_handler(void) {
+    if (g_configured) {
+        sensor_acquisition_schedule_work(&g_drain_work);
+    }
+}
@@ -0,0 +1,346 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Stress test of the condition variable implemented on top of task
+ * notifications in avs_cmsis_os_condvar.c, run against the POSIX emulation of
+ * FreeRTOS in shim/.
+ */
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <FreeRTOS.h>
+#include <cmsis_os.h>
+#include <task.h>
+
+#include <avsystem/commons/avs_condvar.h>
+#include <avsystem/commons/avs_mutex.h>
+#include <avsystem/commons/avs_time.h>
+
+#include "test.h"
+
+// Has to match avs_cmsis_os_condvar.c
+#define CONDVAR_NOTIFICATION_BIT (UINT32_C(1) << 30)
+// Signal of another user of the task notification, as in sensor_acquisition.c
+#define TEST_SIGNAL 0x01
+
+#define BROADCAST_WAITERS 8
+#define BROADCAST_ROUNDS 2000
+#define RACE_ITERATIONS 5000
+
+static avs_time_monotonic_t deadline_in_us(int64_t us) {
+    return avs_time_monotonic_add(avs_time_monotonic_now(),
+                                  avs_time_duration_from_scalar(us,
+                                                                AVS_TIME_US));
+}
+
+static int64_t us_since(avs_time_monotonic_t start) {
+    int64_t result;
+    TEST_ASSERT(!avs_time_duration_to_scalar(
+            &result, AVS_TIME_US,
+            avs_time_monotonic_diff(avs_time_monotonic_now(), start)));
+    return result;
+}
+
+// Neither a condvar notification nor anything else may be left pending
+static void assert_no_notification_left(void) {
+    uint32_t value;
+    TEST_ASSERT(!shim_task_notify_pending(xTaskGetCurrentTaskHandle(),
+                                          &value));
+    TEST_ASSERT(!(value & CONDVAR_NOTIFICATION_BIT));
+}
+
+typedef struct {
+    avs_mutex_t *mutex;
+    avs_condvar_t *condvar;
+    bool ready;
+    atomic_int waiting;
+    int result;
+} single_wait_t;
+
+static void *single_waiter(void *arg) {
+    single_wait_t *wait = (single_wait_t *) arg;
+    avs_mutex_lock(wait->mutex);
+    atomic_fetch_add(&wait->waiting, 1);
+    while (!wait->ready) {
+        wait->result = avs_condvar_wait(wait->condvar, wait->mutex,
+                                        AVS_TIME_MONOTONIC_INVALID);
+    }
+    avs_mutex_unlock(wait->mutex);
+    assert_no_notification_left();
+    return NULL;
+}
+
+static void test_signal(void) {
+    single_wait_t wait = { 0 };
+    TEST_ASSERT(!avs_mutex_create(&wait.mutex));
+    TEST_ASSERT(!avs_condvar_create(&wait.condvar));
+
+    pthread_t thread;
+    TEST_ASSERT(!pthread_create(&thread, NULL, single_waiter, &wait));
+    while (!atomic_load(&wait.waiting)) {
+        usleep(100);
+    }
+    avs_mutex_lock(wait.mutex);
+    wait.ready = true;
+    TEST_ASSERT(!avs_condvar_notify_all(wait.condvar));
+    avs_mutex_unlock(wait.mutex);
+    TEST_ASSERT(!pthread_join(thread, NULL));
+    TEST_ASSERT(wait.result == 0);
+
+    avs_condvar_cleanup(&wait.condvar);
+    avs_mutex_cleanup(&wait.mutex);
+}
+
+static void test_timeout(void) {
+    avs_mutex_t *mutex = NULL;
+    avs_condvar_t *condvar = NULL;
+    TEST_ASSERT(!avs_mutex_create(&mutex));
+    TEST_ASSERT(!avs_condvar_create(&condvar));
+
+    static const int64_t TIMEOUT_US = 50000;
+    avs_time_monotonic_t start = avs_time_monotonic_now();
+    avs_mutex_lock(mutex);
+    TEST_ASSERT(avs_condvar_wait(condvar, mutex, deadline_in_us(TIMEOUT_US))
+                == AVS_CONDVAR_TIMEOUT);
+    avs_mutex_unlock(mutex);
+    TEST_ASSERT(us_since(start) >= TIMEOUT_US);
+
+    // A deadline in the past must not block at all
+    avs_mutex_lock(mutex);
+    TEST_ASSERT(avs_condvar_wait(condvar, mutex, deadline_in_us(-1000))
+                == AVS_CONDVAR_TIMEOUT);
+    avs_mutex_unlock(mutex);
+    assert_no_notification_left();
+
+    avs_condvar_cleanup(&condvar);
+    avs_mutex_cleanup(&mutex);
+}
+
+typedef struct {
+    avs_mutex_t *mutex;
+    avs_condvar_t *round_started;
+    avs_condvar_t *round_acked;
+    int round;
+    int acked;
+} broadcast_t;
+
+static void *broadcast_waiter(void *arg) {
+    broadcast_t *broadcast = (broadcast_t *) arg;
+    unsigned seed = (unsigned) (uintptr_t) pthread_self();
+    avs_mutex_lock(broadcast->mutex);
+    for (int seen = 0; seen < BROADCAST_ROUNDS;) {
+        while (broadcast->round == seen) {
+            // Short deadlines make timeouts race with the broadcasts
+            int64_t timeout_us = rand_r(&seed) % 2000;
+            int result = avs_condvar_wait(broadcast->round_started,
+                                          broadcast->mutex,
+                                          rand_r(&seed) % 4
+                                                  ? deadline_in_us(timeout_us)
+                                                  : AVS_TIME_MONOTONIC_INVALID);
+            TEST_ASSERT(result == 0 || result == AVS_CONDVAR_TIMEOUT);
+        }
+        seen = broadcast->round;
+        if (++broadcast->acked == BROADCAST_WAITERS) {
+            avs_condvar_notify_all(broadcast->round_acked);
+        }
+    }
+    avs_mutex_unlock(broadcast->mutex);
+    assert_no_notification_left();
+    return NULL;
+}
+
+static void test_broadcast(void) {
+    broadcast_t broadcast = { 0 };
+    TEST_ASSERT(!avs_mutex_create(&broadcast.mutex));
+    TEST_ASSERT(!avs_condvar_create(&broadcast.round_started));
+    TEST_ASSERT(!avs_condvar_create(&broadcast.round_acked));
+
+    pthread_t threads[BROADCAST_WAITERS];
+    for (int i = 0; i < BROADCAST_WAITERS; i++) {
+        TEST_ASSERT(!pthread_create(&threads[i], NULL, broadcast_waiter,
+                                    &broadcast));
+    }
+    avs_mutex_lock(broadcast.mutex);
+    for (int round = 1; round <= BROADCAST_ROUNDS; round++) {
+        broadcast.acked = 0;
+        broadcast.round = round;
+        avs_condvar_notify_all(broadcast.round_started);
+        while (broadcast.acked < BROADCAST_WAITERS) {
+            TEST_ASSERT(avs_condvar_wait(broadcast.round_acked,
+                                         broadcast.mutex,
+                                         AVS_TIME_MONOTONIC_INVALID)
+                        == 0);
+        }
+    }
+    avs_mutex_unlock(broadcast.mutex);
+    for (int i = 0; i < BROADCAST_WAITERS; i++) {
+        TEST_ASSERT(!pthread_join(threads[i], NULL));
+    }
+    assert_no_notification_left();
+
+    avs_condvar_cleanup(&broadcast.round_acked);
+    avs_condvar_cleanup(&broadcast.round_started);
+    avs_mutex_cleanup(&broadcast.mutex);
+}
+
+static avs_condvar_t *g_late_condvar;
+
+static void notify_late(void) {
+    TEST_ASSERT(!avs_condvar_notify_all(g_late_condvar));
+}
+
+/**
+ * A notification which comes after the waiter has timed out, but before it has
+ * removed itself from the condition variable, must not be left pending, while
+ * signals of other users of the task notification must be kept.
+ */
+static void test_late_notification(void) {
+    avs_mutex_t *mutex = NULL;
+    TEST_ASSERT(!avs_mutex_create(&mutex));
+    TEST_ASSERT(!avs_condvar_create(&g_late_condvar));
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+
+    for (int signalled = 0; signalled < 2; signalled++) {
+        if (signalled) {
+            (void) osSignalSet(self, TEST_SIGNAL);
+        }
+        shim_task_notify_wait_timeout_hook = notify_late;
+        avs_mutex_lock(mutex);
+        // Notified before removed from the condition variable, so not a timeout
+        TEST_ASSERT(avs_condvar_wait(g_late_condvar, mutex,
+                                     deadline_in_us(1000))
+                    == 0);
+        avs_mutex_unlock(mutex);
+        shim_task_notify_wait_timeout_hook = NULL;
+
+        uint32_t value;
+        TEST_ASSERT(!!shim_task_notify_pending(self, &value) == signalled);
+        TEST_ASSERT(!(value & CONDVAR_NOTIFICATION_BIT));
+        osEvent event = osSignalWait(TEST_SIGNAL, 0);
+        TEST_ASSERT(event.status == (signalled ? osEventSignal : osOK));
+        assert_no_notification_left();
+
+        // The next wait must not return early
+        static const int64_t TIMEOUT_US = 10000;
+        avs_time_monotonic_t start = avs_time_monotonic_now();
+        avs_mutex_lock(mutex);
+        TEST_ASSERT(avs_condvar_wait(g_late_condvar, mutex,
+                                     deadline_in_us(TIMEOUT_US))
+                    == AVS_CONDVAR_TIMEOUT);
+        avs_mutex_unlock(mutex);
+        TEST_ASSERT(us_since(start) >= TIMEOUT_US);
+    }
+
+    avs_condvar_cleanup(&g_late_condvar);
+    avs_mutex_cleanup(&mutex);
+}
+
+typedef struct {
+    avs_condvar_t *condvar;
+    TaskHandle_t waiter;
+    sem_t start;
+    sem_t done;
+    atomic_bool stop;
+    // Whether TEST_SIGNAL was set in the current iteration
+    bool signalled;
+} race_t;
+
+static void *race_notifier(void *arg) {
+    race_t *race = (race_t *) arg;
+    unsigned seed = 1;
+    while (true) {
+        sem_wait(&race->start);
+        if (atomic_load(&race->stop)) {
+            return NULL;
+        }
+        // Around the deadline of the waiter, which is 1 ms
+        usleep((useconds_t) (500 + rand_r(&seed) % 1000));
+        avs_condvar_notify_all(race->condvar);
+        race->signalled = rand_r(&seed) % 2;
+        if (race->signalled) {
+            (void) osSignalSet(race->waiter, TEST_SIGNAL);
+        }
+        sem_post(&race->done);
+    }
+}
+
+/**
+ * Same as test_late_notification, but with notifications and signals coming
+ * from another thread at random moments around the deadline.
+ */
+static void test_timeout_race(void) {
+    avs_mutex_t *mutex = NULL;
+    race_t race = {
+        .waiter = xTaskGetCurrentTaskHandle()
+    };
+    TEST_ASSERT(!avs_mutex_create(&mutex));
+    TEST_ASSERT(!avs_condvar_create(&race.condvar));
+    TEST_ASSERT(!sem_init(&race.start, 0, 0));
+    TEST_ASSERT(!sem_init(&race.done, 0, 0));
+
+    pthread_t thread;
+    TEST_ASSERT(!pthread_create(&thread, NULL, race_notifier, &race));
+    int timeouts = 0;
+    for (int i = 0; i < RACE_ITERATIONS; i++) {
+        avs_mutex_lock(mutex);
+        sem_post(&race.start);
+        int result =
+                avs_condvar_wait(race.condvar, mutex, deadline_in_us(1000));
+        TEST_ASSERT(result == 0 || result == AVS_CONDVAR_TIMEOUT);
+        timeouts += (result == AVS_CONDVAR_TIMEOUT);
+        avs_mutex_unlock(mutex);
+        sem_wait(&race.done);
+
+        uint32_t value;
+        BaseType_t pending = shim_task_notify_pending(race.waiter, &value);
+        TEST_ASSERT(!(value & CONDVAR_NOTIFICATION_BIT));
+        TEST_ASSERT(!!pending == race.signalled);
+        osEvent event = osSignalWait(TEST_SIGNAL, 0);
+        if (race.signalled) {
+            TEST_ASSERT(event.status == osEventSignal);
+            TEST_ASSERT(event.value.signals == TEST_SIGNAL);
+        } else {
+            TEST_ASSERT(event.status == osOK);
+        }
+        assert_no_notification_left();
+    }
+    atomic_store(&race.stop, true);
+    sem_post(&race.start);
+    TEST_ASSERT(!pthread_join(thread, NULL));
+    printf("%d of %d waits timed out\n", timeouts, RACE_ITERATIONS);
+
+    sem_destroy(&race.done);
+    sem_destroy(&race.start);
+    avs_condvar_cleanup(&race.condvar);
+    avs_mutex_cleanup(&mutex);
+}
+
+int main(void) {
+    TEST_RUN(test_signal);
+    TEST_RUN(test_timeout);
+    TEST_RUN(test_broadcast);
+    TEST_RUN(test_late_notification);
+    TEST_RUN(test_timeout_race);
+    return 0;
+}
@@ -0,0 +1,350 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests of the size-class pools behind avs_malloc() and the mbedTLS
+ * allocator, implemented in avs_pool_allocator.c: symmetry of allocations and
+ * frees of each kind of block, and a multithreaded soak test which also prints
+ * the pool usage it has reached.
+ */
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <mbedtls/platform.h>
+
+#include <avsystem/commons/avs_memory.h>
+
+#include "pool_allocator.h"
+#include "test.h"
+
+// Size of the header preceding the blocks which are not served from a pool
+#define HEAP_HEADER_SIZE 8
+
+#define SOAK_THREADS 4
+#define SOAK_ITERATIONS 200000
+#define SOAK_SLOTS 48
+
+typedef struct {
+    pool_allocator_tag_stats_t tags[POOL_ALLOCATOR_TAGS_COUNT];
+} tag_snapshot_t;
+
+static void snapshot_tags(tag_snapshot_t *out) {
+    for (int tag = 0; tag < POOL_ALLOCATOR_TAGS_COUNT; tag++) {
+        pool_allocator_get_tag_stats((pool_allocator_tag_t) tag,
+                                     &out->tags[tag]);
+    }
+}
+
+static pool_allocator_pool_stats_t pool_stats_for_size(size_t size) {
+    pool_allocator_pool_stats_t stats = { 0 };
+    for (size_t i = 0; i < pool_allocator_pools_count(); i++) {
+        pool_allocator_get_pool_stats(i, &stats);
+        if (size <= stats.block_size) {
+            return stats;
+        }
+    }
+    // Larger than the largest class
+    stats.block_size = 0;
+    return stats;
+}
+
+static void assert_all_freed(void) {
+    for (int tag = 0; tag < POOL_ALLOCATOR_TAGS_COUNT; tag++) {
+        pool_allocator_tag_stats_t stats;
+        pool_allocator_get_tag_stats((pool_allocator_tag_t) tag, &stats);
+        TEST_ASSERT(stats.bytes == 0);
+        TEST_ASSERT(stats.allocations == 0);
+    }
+    for (size_t i = 0; i < pool_allocator_pools_count(); i++) {
+        pool_allocator_pool_stats_t stats;
+        pool_allocator_get_pool_stats(i, &stats);
+        TEST_ASSERT(stats.used == 0);
+    }
+}
+
+static bool all_zero(const uint8_t *data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        if (data[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * mbedTLS frees with avs_free() what it has allocated with tls_calloc(), for
+ * pool blocks as well as for blocks with a heap header.
+ */
+static void test_tls_calloc_free_symmetry(void) {
+    static const size_t SIZES[] = { 1, 16, 17, 64, 100, 128, 129, 4096 };
+    pool_allocator_init();
+    TEST_ASSERT(mbedtls_free == avs_free);
+
+    for (size_t i = 0; i < sizeof(SIZES) / sizeof(SIZES[0]); i++) {
+        tag_snapshot_t before;
+        snapshot_tags(&before);
+        pool_allocator_pool_stats_t pool_before = pool_stats_for_size(SIZES[i]);
+
+        uint8_t *block = (uint8_t *) mbedtls_calloc(1, SIZES[i]);
+        TEST_ASSERT(block);
+        TEST_ASSERT(all_zero(block, SIZES[i]));
+        memset(block, 0xA5, SIZES[i]);
+
+        pool_allocator_tag_stats_t tls;
+        pool_allocator_get_tag_stats(POOL_ALLOCATOR_TAG_TLS, &tls);
+        size_t held = pool_before.block_size ? pool_before.block_size
+                                             : HEAP_HEADER_SIZE + SIZES[i];
+        TEST_ASSERT(tls.allocations
+                    == before.tags[POOL_ALLOCATOR_TAG_TLS].allocations + 1);
+        TEST_ASSERT(tls.bytes
+                    == before.tags[POOL_ALLOCATOR_TAG_TLS].bytes + held);
+        if (pool_before.block_size) {
+            TEST_ASSERT(pool_stats_for_size(SIZES[i]).used
+                        == pool_before.used + 1);
+        }
+
+        mbedtls_free(block);
+        tag_snapshot_t after;
+        snapshot_tags(&after);
+        for (int tag = 0; tag < POOL_ALLOCATOR_TAGS_COUNT; tag++) {
+            TEST_ASSERT(after.tags[tag].bytes == before.tags[tag].bytes);
+            TEST_ASSERT(after.tags[tag].allocations
+                        == before.tags[tag].allocations);
+        }
+    }
+    assert_all_freed();
+}
+
+/**
+ * Once a pool is exhausted, requests of its class are served from the heap,
+ * with a header, and still freed symmetrically.
+ */
+static void test_exhausted_pool(void) {
+    pool_allocator_pool_stats_t pool = pool_stats_for_size(1);
+    size_t count = pool.block_count + 2U;
+    void **blocks = (void **) calloc(count, sizeof(void *));
+    TEST_ASSERT(blocks);
+
+    for (size_t i = 0; i < count; i++) {
+        blocks[i] = mbedtls_calloc(1, pool.block_size);
+        TEST_ASSERT(blocks[i]);
+    }
+    pool_allocator_pool_stats_t exhausted = pool_stats_for_size(1);
+    TEST_ASSERT(exhausted.used == pool.block_count);
+    TEST_ASSERT(exhausted.overflows == pool.overflows + 2);
+    pool_allocator_tag_stats_t tls;
+    pool_allocator_get_tag_stats(POOL_ALLOCATOR_TAG_TLS, &tls);
+    TEST_ASSERT(tls.bytes
+                == (size_t) pool.block_count * pool.block_size
+                           + 2 * (HEAP_HEADER_SIZE + pool.block_size));
+
+    // Free in a different order than allocated
+    for (size_t i = count; i-- > 0;) {
+        mbedtls_free(blocks[(i * 7) % count]);
+    }
+    free(blocks);
+    assert_all_freed();
+}
+
+static void test_realloc(void) {
+    static const size_t SIZES[] = { 10, 30, 60, 120, 500, 3000, 40 };
+    uint8_t *data = NULL;
+    size_t size = 0;
+    for (size_t i = 0; i < sizeof(SIZES) / sizeof(SIZES[0]); i++) {
+        uint8_t *grown = (uint8_t *) avs_realloc(data, SIZES[i]);
+        TEST_ASSERT(grown);
+        for (size_t j = 0; j < size && j < SIZES[i]; j++) {
+            TEST_ASSERT(grown[j] == (uint8_t) j);
+        }
+        for (size_t j = 0; j < SIZES[i]; j++) {
+            grown[j] = (uint8_t) j;
+        }
+        data = grown;
+        size = SIZES[i];
+    }
+    TEST_ASSERT(!avs_realloc(data, 0));
+    assert_all_freed();
+}
+
+static void *tagged_thread(void *arg) {
+    (void) arg;
+    pool_allocator_tag_current_thread(POOL_ALLOCATOR_TAG_LWM2M);
+    tag_snapshot_t before;
+    snapshot_tags(&before);
+    void *block = avs_malloc(24);
+    TEST_ASSERT(block);
+    tag_snapshot_t after;
+    snapshot_tags(&after);
+    TEST_ASSERT(after.tags[POOL_ALLOCATOR_TAG_LWM2M].allocations
+                == before.tags[POOL_ALLOCATOR_TAG_LWM2M].allocations + 1);
+    TEST_ASSERT(after.tags[POOL_ALLOCATOR_TAG_APPLICATION].allocations
+                == before.tags[POOL_ALLOCATOR_TAG_APPLICATION].allocations);
+    avs_free(block);
+    return NULL;
+}
+
+static void test_thread_tags(void) {
+    pthread_t thread;
+    TEST_ASSERT(!pthread_create(&thread, NULL, tagged_thread, NULL));
+    TEST_ASSERT(!pthread_join(thread, NULL));
+    assert_all_freed();
+}
+
+typedef struct {
+    int index;
+    unsigned seed;
+    uint8_t *blocks[SOAK_SLOTS];
+    size_t sizes[SOAK_SLOTS];
+} soak_thread_t;
+
+// Mostly small blocks, as in the CoAP and TLS layers, with a tail of large
+// ones that have to fall back to the heap
+static size_t random_size(unsigned *seed) {
+    int kind = rand_r(seed) % 100;
+    if (kind < 60) {
+        return 1 + (size_t) (rand_r(seed) % 32);
+    } else if (kind < 90) {
+        return 33 + (size_t) (rand_r(seed) % 96);
+    }
+    return 129 + (size_t) (rand_r(seed) % 2048);
+}
+
+static uint8_t pattern(const soak_thread_t *thread, int slot, size_t offset) {
+    return (uint8_t) (thread->index * 61 + slot * 7 + (int) offset);
+}
+
+static void fill(soak_thread_t *thread, int slot, size_t from) {
+    for (size_t i = from; i < thread->sizes[slot]; i++) {
+        thread->blocks[slot][i] = pattern(thread, slot, i);
+    }
+}
+
+static void check(const soak_thread_t *thread, int slot) {
+    for (size_t i = 0; i < thread->sizes[slot]; i++) {
+        TEST_ASSERT(thread->blocks[slot][i] == pattern(thread, slot, i));
+    }
+}
+
+static void *soak_thread(void *arg) {
+    soak_thread_t *thread = (soak_thread_t *) arg;
+    // Thread 0 stays untagged, thread 2 allocates as mbedTLS does
+    bool tls = thread->index == 2;
+    if (thread->index == 1 || thread->index == 3) {
+        pool_allocator_tag_current_thread(POOL_ALLOCATOR_TAG_LWM2M);
+    }
+
+    for (int i = 0; i < SOAK_ITERATIONS; i++) {
+        int slot = rand_r(&thread->seed) % SOAK_SLOTS;
+        if (!thread->blocks[slot]) {
+            size_t size = random_size(&thread->seed);
+            thread->blocks[slot] =
+                    (uint8_t *) (tls ? mbedtls_calloc(1, size)
+                                     : avs_malloc(size));
+            TEST_ASSERT(thread->blocks[slot]);
+            thread->sizes[slot] = size;
+            fill(thread, slot, 0);
+            continue;
+        }
+        check(thread, slot);
+        if (!tls && rand_r(&thread->seed) % 4 == 0) {
+            size_t size = random_size(&thread->seed);
+            uint8_t *block =
+                    (uint8_t *) avs_realloc(thread->blocks[slot], size);
+            TEST_ASSERT(block);
+            size_t kept = thread->sizes[slot] < size ? thread->sizes[slot]
+                                                      : size;
+            thread->blocks[slot] = block;
+            thread->sizes[slot] = kept;
+            check(thread, slot);
+            thread->sizes[slot] = size;
+            fill(thread, slot, kept);
+        } else {
+            (tls ? mbedtls_free : avs_free)(thread->blocks[slot]);
+            thread->blocks[slot] = NULL;
+        }
+    }
+
+    for (int slot = 0; slot < SOAK_SLOTS; slot++) {
+        if (thread->blocks[slot]) {
+            check(thread, slot);
+            (tls ? mbedtls_free : avs_free)(thread->blocks[slot]);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Random allocations, reallocations and frees from several threads, with data
+ * patterns checked on every access. Afterwards, every byte and every pool
+ * block must have been returned.
+ */
+static void test_soak(void) {
+    for (int tag = 0; tag < POOL_ALLOCATOR_TAGS_COUNT; tag++) {
+        pool_allocator_reset_high_water((pool_allocator_tag_t) tag);
+    }
+    static soak_thread_t threads[SOAK_THREADS];
+    pthread_t ids[SOAK_THREADS];
+    for (int i = 0; i < SOAK_THREADS; i++) {
+        threads[i].index = i;
+        threads[i].seed = (unsigned) i + 1;
+        TEST_ASSERT(!pthread_create(&ids[i], NULL, soak_thread, &threads[i]));
+    }
+    for (int i = 0; i < SOAK_THREADS; i++) {
+        TEST_ASSERT(!pthread_join(ids[i], NULL));
+    }
+    assert_all_freed();
+    for (int tag = 0; tag < POOL_ALLOCATOR_TAGS_COUNT; tag++) {
+        pool_allocator_tag_stats_t stats;
+        pool_allocator_get_tag_stats((pool_allocator_tag_t) tag, &stats);
+        TEST_ASSERT(stats.failures == 0);
+    }
+
+    // Every block of every pool can still be allocated, i.e. none was lost
+    for (size_t i = 0; i < pool_allocator_pools_count(); i++) {
+        pool_allocator_pool_stats_t pool;
+        pool_allocator_get_pool_stats(i, &pool);
+        void **blocks = (void **) calloc(pool.block_count, sizeof(void *));
+        TEST_ASSERT(blocks);
+        for (size_t j = 0; j < pool.block_count; j++) {
+            blocks[j] = avs_malloc(pool.block_size);
+            TEST_ASSERT(blocks[j]);
+        }
+        pool_allocator_pool_stats_t full;
+        pool_allocator_get_pool_stats(i, &full);
+        TEST_ASSERT(full.used == full.block_count);
+        TEST_ASSERT(full.overflows == pool.overflows);
+        for (size_t j = 0; j < pool.block_count; j++) {
+            avs_free(blocks[j]);
+        }
+        free(blocks);
+    }
+
+    // Synthetic load only, not a substitute for sizing on the target
+    pool_allocator_log_stats();
+}
+
+int main(void) {
+    TEST_RUN(test_tls_calloc_free_symmetry);
+    TEST_RUN(test_exhausted_pool);
+    TEST_RUN(test_realloc);
+    TEST_RUN(test_thread_tags);
+    TEST_RUN(test_soak);
+    return 0;
+}
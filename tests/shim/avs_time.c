@@ -0,0 +1,113 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <time.h>
+
+#include <avsystem/commons/avs_time.h>
+
+#define NS_IN_S 1000000000LL
+
+const avs_time_duration_t AVS_TIME_DURATION_ZERO = { 0, 0 };
+const avs_time_monotonic_t AVS_TIME_MONOTONIC_INVALID = { { 0, -1 } };
+
+static int64_t to_ns(avs_time_duration_t duration) {
+    return duration.seconds * NS_IN_S + duration.nanoseconds;
+}
+
+static avs_time_duration_t from_ns(int64_t ns) {
+    avs_time_duration_t result = {
+        .seconds = ns / NS_IN_S,
+        .nanoseconds = (int32_t) (ns % NS_IN_S)
+    };
+    if (result.nanoseconds < 0) {
+        result.seconds--;
+        result.nanoseconds += (int32_t) NS_IN_S;
+    }
+    return result;
+}
+
+static int64_t unit_ns(avs_time_unit_t unit) {
+    switch (unit) {
+    case AVS_TIME_S:
+        return NS_IN_S;
+    case AVS_TIME_MS:
+        return 1000000;
+    case AVS_TIME_US:
+        return 1000;
+    default:
+        return 1;
+    }
+}
+
+bool avs_time_duration_valid(avs_time_duration_t t) {
+    return t.nanoseconds >= 0 && t.nanoseconds < NS_IN_S;
+}
+
+bool avs_time_duration_less(avs_time_duration_t a, avs_time_duration_t b) {
+    return avs_time_duration_valid(a) && avs_time_duration_valid(b)
+           && to_ns(a) < to_ns(b);
+}
+
+int avs_time_duration_to_scalar(int64_t *out,
+                                avs_time_unit_t unit,
+                                avs_time_duration_t duration) {
+    if (!avs_time_duration_valid(duration)) {
+        return -1;
+    }
+    *out = to_ns(duration) / unit_ns(unit);
+    return 0;
+}
+
+avs_time_duration_t avs_time_duration_from_scalar(int64_t value,
+                                                  avs_time_unit_t unit) {
+    return from_ns(value * unit_ns(unit));
+}
+
+bool avs_time_monotonic_valid(avs_time_monotonic_t t) {
+    return avs_time_duration_valid(t.since_monotonic_epoch);
+}
+
+avs_time_monotonic_t avs_time_monotonic_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (avs_time_monotonic_t) {
+        .since_monotonic_epoch = {
+            .seconds = now.tv_sec,
+            .nanoseconds = (int32_t) now.tv_nsec
+        }
+    };
+}
+
+avs_time_monotonic_t avs_time_monotonic_add(avs_time_monotonic_t t,
+                                            avs_time_duration_t duration) {
+    if (!avs_time_monotonic_valid(t) || !avs_time_duration_valid(duration)) {
+        return AVS_TIME_MONOTONIC_INVALID;
+    }
+    return (avs_time_monotonic_t) {
+        .since_monotonic_epoch =
+                from_ns(to_ns(t.since_monotonic_epoch) + to_ns(duration))
+    };
+}
+
+avs_time_duration_t avs_time_monotonic_diff(avs_time_monotonic_t minuend,
+                                            avs_time_monotonic_t subtrahend) {
+    if (!avs_time_monotonic_valid(minuend)
+            || !avs_time_monotonic_valid(subtrahend)) {
+        return AVS_TIME_MONOTONIC_INVALID.since_monotonic_epoch;
+    }
+    return from_ns(to_ns(minuend.since_monotonic_epoch)
+                   - to_ns(subtrahend.since_monotonic_epoch));
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHIM_AVS_CONDVAR_H
+#define SHIM_AVS_CONDVAR_H
+
+#include "avs_mutex.h"
+#include "avs_time.h"
+
+#define AVS_CONDVAR_TIMEOUT 1
+
+typedef struct avs_condvar avs_condvar_t;
+
+int avs_condvar_create(avs_condvar_t **out_condvar);
+int avs_condvar_notify_all(avs_condvar_t *condvar);
+int avs_condvar_wait(avs_condvar_t *condvar,
+                     avs_mutex_t *mutex,
+                     avs_time_monotonic_t deadline);
+void avs_condvar_cleanup(avs_condvar_t **condvar);
+
+#endif // SHIM_AVS_CONDVAR_H
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHIM_AVS_DEFS_H
+#define SHIM_AVS_DEFS_H
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define AVS_ARRAY_SIZE(Array) (sizeof(Array) / sizeof((Array)[0]))
+#define AVS_ALIGNOF(Type) _Alignof(Type)
+#define AVS_STATIC_ASSERT(Condition, Message) \
+    _Static_assert(Condition, #Message)
+#define AVS_ASSERT(Condition, Message) assert((Condition) && (Message))
+#define AVS_MIN(A, B) ((A) < (B) ? (A) : (B))
+#define AVS_MAX(A, B) ((A) > (B) ? (A) : (B))
+#define AVS_CONTAINER_OF(Ptr, Type, Member) \
+    ((Type *) (void *) ((char *) (intptr_t) (Ptr) - offsetof(Type, Member)))
+
+#endif // SHIM_AVS_DEFS_H
@@ -0,0 +1,27 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHIM_AVS_MEMORY_H
+#define SHIM_AVS_MEMORY_H
+
+#include <stddef.h>
+
+void *avs_malloc(size_t size);
+void *avs_calloc(size_t nmemb, size_t size);
+void *avs_realloc(void *ptr, size_t size);
+void avs_free(void *ptr);
+
+#endif // SHIM_AVS_MEMORY_H
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHIM_AVS_TIME_H
+#define SHIM_AVS_TIME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+    int64_t seconds;
+    int32_t nanoseconds;
+} avs_time_duration_t;
+
+typedef struct {
+    avs_time_duration_t since_monotonic_epoch;
+} avs_time_monotonic_t;
+
+typedef enum {
+    AVS_TIME_S,
+    AVS_TIME_MS,
+    AVS_TIME_US,
+    AVS_TIME_NS
+} avs_time_unit_t;
+
+extern const avs_time_duration_t AVS_TIME_DURATION_ZERO;
+extern const avs_time_monotonic_t AVS_TIME_MONOTONIC_INVALID;
+
+bool avs_time_duration_valid(avs_time_duration_t t);
+bool avs_time_duration_less(avs_time_duration_t a, avs_time_duration_t b);
+int avs_time_duration_to_scalar(int64_t *out,
+                                avs_time_unit_t unit,
+                                avs_time_duration_t duration);
+avs_time_duration_t avs_time_duration_from_scalar(int64_t value,
+                                                  avs_time_unit_t unit);
+
+bool avs_time_monotonic_valid(avs_time_monotonic_t t);
+avs_time_monotonic_t avs_time_monotonic_now(void);
+avs_time_monotonic_t avs_time_monotonic_add(avs_time_monotonic_t t,
+                                            avs_time_duration_t duration);
+avs_time_duration_t avs_time_monotonic_diff(avs_time_monotonic_t minuend,
+                                            avs_time_monotonic_t subtrahend);
+
+#endif // SHIM_AVS_TIME_H
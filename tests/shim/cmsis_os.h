@@ -0,0 +1,72 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Host replacement of the part of the CMSIS-RTOS v1 API that FreeRTOS
+ * implements, limited to what the code under test uses.
+ */
+#ifndef SHIM_CMSIS_OS_H
+#define SHIM_CMSIS_OS_H
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define osWaitForever 0xFFFFFFFF
+
+typedef enum {
+    osOK = 0,
+    osEventSignal = 0x08,
+    osEventTimeout = 0x40,
+    osErrorResource = 0x81,
+    osErrorValue = 0x86,
+    osErrorOS = 0xFF
+} osStatus;
+
+typedef struct {
+    osStatus status;
+    union {
+        uint32_t v;
+        int32_t signals;
+    } value;
+} osEvent;
+
+typedef TaskHandle_t osThreadId;
+
+typedef struct {
+    pthread_mutex_t mutex;
+} osStaticMutexDef_t;
+
+typedef struct os_mutex_def {
+    uint32_t dummy;
+    osStaticMutexDef_t *controlblock;
+} osMutexDef_t;
+
+typedef osStaticMutexDef_t *osMutexId;
+
+osThreadId osThreadGetId(void);
+
+int32_t osSignalSet(osThreadId thread_id, int32_t signal);
+osEvent osSignalWait(int32_t signals, uint32_t millisec);
+
+osMutexId osMutexCreate(const osMutexDef_t *mutex_def);
+osStatus osMutexWait(osMutexId mutex_id, uint32_t millisec);
+osStatus osMutexRelease(osMutexId mutex_id);
+osStatus osMutexDelete(osMutexId mutex_id);
+
+#endif // SHIM_CMSIS_OS_H
@@ -0,0 +1,209 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// For PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "cmsis_os.h"
+#include "task.h"
+
+struct tskTaskControlBlock {
+    bool initialized;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t value;
+    bool pending;
+};
+
+void (*shim_task_notify_wait_timeout_hook)(void);
+
+static _Thread_local struct tskTaskControlBlock g_current_task;
+
+// vTaskSuspendAll() calls may be nested
+static pthread_mutex_t g_scheduler_mutex =
+        PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    TaskHandle_t task = &g_current_task;
+    if (!task->initialized) {
+        pthread_condattr_t attr;
+        pthread_condattr_init(&attr);
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        pthread_mutex_init(&task->mutex, NULL);
+        pthread_cond_init(&task->cond, &attr);
+        pthread_condattr_destroy(&attr);
+        task->initialized = true;
+    }
+    return task;
+}
+
+BaseType_t xTaskNotifyWait(uint32_t ulBitsToClearOnEntry,
+                           uint32_t ulBitsToClearOnExit,
+                           uint32_t *pulNotificationValue,
+                           TickType_t xTicksToWait) {
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    pthread_mutex_lock(&task->mutex);
+    if (!task->pending) {
+        task->value &= ~ulBitsToClearOnEntry;
+        if (xTicksToWait == portMAX_DELAY) {
+            while (!task->pending) {
+                pthread_cond_wait(&task->cond, &task->mutex);
+            }
+        } else if (xTicksToWait > 0) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_MONOTONIC, &deadline);
+            deadline.tv_sec += xTicksToWait / 1000;
+            deadline.tv_nsec += (long) (xTicksToWait % 1000) * 1000000L;
+            if (deadline.tv_nsec >= 1000000000L) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000L;
+            }
+            while (!task->pending
+                   && pthread_cond_timedwait(&task->cond, &task->mutex,
+                                             &deadline)
+                              != ETIMEDOUT) {
+            }
+        }
+    }
+    if (pulNotificationValue) {
+        *pulNotificationValue = task->value;
+    }
+    BaseType_t result = pdFALSE;
+    if (task->pending) {
+        task->value &= ~ulBitsToClearOnExit;
+        result = pdTRUE;
+    }
+    task->pending = false;
+    pthread_mutex_unlock(&task->mutex);
+    if (!result && xTicksToWait > 0
+            && shim_task_notify_wait_timeout_hook) {
+        shim_task_notify_wait_timeout_hook();
+    }
+    return result;
+}
+
+BaseType_t xTaskNotify(TaskHandle_t xTaskToNotify,
+                       uint32_t ulValue,
+                       eNotifyAction eAction) {
+    BaseType_t result = pdPASS;
+    pthread_mutex_lock(&xTaskToNotify->mutex);
+    switch (eAction) {
+    case eNoAction:
+        break;
+    case eSetBits:
+        xTaskToNotify->value |= ulValue;
+        break;
+    case eIncrement:
+        xTaskToNotify->value++;
+        break;
+    case eSetValueWithOverwrite:
+        xTaskToNotify->value = ulValue;
+        break;
+    case eSetValueWithoutOverwrite:
+        if (xTaskToNotify->pending) {
+            result = pdFALSE;
+        } else {
+            xTaskToNotify->value = ulValue;
+        }
+        break;
+    }
+    xTaskToNotify->pending = true;
+    pthread_cond_broadcast(&xTaskToNotify->cond);
+    pthread_mutex_unlock(&xTaskToNotify->mutex);
+    return result;
+}
+
+BaseType_t shim_task_notify_pending(TaskHandle_t xTask, uint32_t *out_value) {
+    pthread_mutex_lock(&xTask->mutex);
+    BaseType_t result = xTask->pending ? pdTRUE : pdFALSE;
+    if (out_value) {
+        *out_value = xTask->value;
+    }
+    pthread_mutex_unlock(&xTask->mutex);
+    return result;
+}
+
+void vTaskSuspendAll(void) {
+    pthread_mutex_lock(&g_scheduler_mutex);
+}
+
+BaseType_t xTaskResumeAll(void) {
+    pthread_mutex_unlock(&g_scheduler_mutex);
+    return pdFALSE;
+}
+
+osThreadId osThreadGetId(void) {
+    return xTaskGetCurrentTaskHandle();
+}
+
+int32_t osSignalSet(osThreadId thread_id, int32_t signal) {
+    uint32_t previous;
+    (void) shim_task_notify_pending(thread_id, &previous);
+    (void) xTaskNotify(thread_id, (uint32_t) signal, eSetBits);
+    return (int32_t) previous;
+}
+
+osEvent osSignalWait(int32_t signals, uint32_t millisec) {
+    osEvent ret = {
+        .status = osOK
+    };
+    TickType_t ticks = 0;
+    if (millisec == osWaitForever) {
+        ticks = portMAX_DELAY;
+    } else if (millisec != 0) {
+        ticks = millisec / portTICK_PERIOD_MS;
+        if (ticks == 0) {
+            ticks = 1;
+        }
+    }
+    if (xTaskNotifyWait(0, (uint32_t) signals, &ret.value.v, ticks)
+            != pdTRUE) {
+        ret.status = ticks == 0 ? osOK : osEventTimeout;
+    } else if (ret.value.signals < 0) {
+        ret.status = osErrorValue;
+    } else {
+        ret.status = osEventSignal;
+    }
+    return ret;
+}
+
+osMutexId osMutexCreate(const osMutexDef_t *mutex_def) {
+    if (pthread_mutex_init(&mutex_def->controlblock->mutex, NULL)) {
+        return NULL;
+    }
+    return mutex_def->controlblock;
+}
+
+osStatus osMutexWait(osMutexId mutex_id, uint32_t millisec) {
+    if (millisec == osWaitForever) {
+        return pthread_mutex_lock(&mutex_id->mutex) ? osErrorOS : osOK;
+    }
+    // Timed waits are not used by the code under test
+    return pthread_mutex_trylock(&mutex_id->mutex) ? osErrorOS : osOK;
+}
+
+osStatus osMutexRelease(osMutexId mutex_id) {
+    return pthread_mutex_unlock(&mutex_id->mutex) ? osErrorOS : osOK;
+}
+
+osStatus osMutexDelete(osMutexId mutex_id) {
+    return pthread_mutex_destroy(&mutex_id->mutex) ? osErrorOS : osOK;
+}
@@ -0,0 +1,29 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHIM_MBEDTLS_PLATFORM_H
+#define SHIM_MBEDTLS_PLATFORM_H
+
+#include <stddef.h>
+
+// As with MBEDTLS_PLATFORM_MEMORY, set by mbedtls_platform_set_calloc_free()
+extern void *(*mbedtls_calloc)(size_t nmemb, size_t size);
+extern void (*mbedtls_free)(void *ptr);
+
+int mbedtls_platform_set_calloc_free(void *(*calloc_func)(size_t, size_t),
+                                     void (*free_func)(void *));
+
+#endif // SHIM_MBEDTLS_PLATFORM_H
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHIM_TASK_H
+#define SHIM_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef struct tskTaskControlBlock *TaskHandle_t;
+
+typedef enum {
+    eNoAction = 0,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite
+} eNotifyAction;
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+
+/**
+ * Same semantics as in FreeRTOS V10.3.1: the bits to clear on exit are only
+ * cleared if a notification was pending, and waiting always consumes the
+ * pending state.
+ */
+BaseType_t xTaskNotifyWait(uint32_t ulBitsToClearOnEntry,
+                           uint32_t ulBitsToClearOnExit,
+                           uint32_t *pulNotificationValue,
+                           TickType_t xTicksToWait);
+
+BaseType_t xTaskNotify(TaskHandle_t xTaskToNotify,
+                       uint32_t ulValue,
+                       eNotifyAction eAction);
+
+/**
+ * Returns whether a notification is pending for the task, for the tests only.
+ */
+BaseType_t shim_task_notify_pending(TaskHandle_t xTask, uint32_t *out_value);
+
+/**
+ * If set, called by the task itself right after xTaskNotifyWait() has timed
+ * out, for the tests to notify it at the least convenient moment.
+ */
+extern void (*shim_task_notify_wait_timeout_hook)(void);
+
+// The scheduler is emulated by a single recursive lock
+void vTaskSuspendAll(void);
+BaseType_t xTaskResumeAll(void);
+
+#endif // SHIM_TASK_H
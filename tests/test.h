@@ -0,0 +1,39 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// Unlike assert(), also checked in release builds
+#define TEST_ASSERT(Condition)                                          \
+    do {                                                                \
+        if (!(Condition)) {                                             \
+            fprintf(stderr, "%s:%d: assertion failed: %s\n", __FILE__, \
+                    __LINE__, #Condition);                              \
+            abort();                                                    \
+        }                                                               \
+    } while (0)
+
+#define TEST_RUN(Test)              \
+    do {                            \
+        printf("%s\n", #Test);      \
+        Test();                     \
+    } while (0)
+
+#endif // TEST_H